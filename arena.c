@@ -0,0 +1,54 @@
+#include "arena.h"
+#include "memtrack.h"
+#include <stdio.h>
+#include <string.h>
+
+#define ARENA_ALIGNMENT 16
+
+Arena game_arena;
+Arena frame_arena;
+
+int arena_init(Arena *arena, size_t capacity) {
+  arena->base = mem_alloc(capacity, MEM_GAME);
+  arena->capacity = arena->base ? capacity : 0;
+  arena->used = 0;
+  arena->peak = 0;
+  if (!arena->base) {
+    printf("Error: Could not allocate arena of %lu bytes\n",
+           (unsigned long)capacity);
+    return 0;
+  }
+  return 1;
+}
+
+// Returns NULL when the arena is full; callers treat that like a full store
+void *arena_alloc(Arena *arena, size_t size) {
+  size_t start = (arena->used + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+  if (start + size > arena->capacity) {
+    printf("Warning: Arena out of memory (%lu of %lu bytes used, %lu "
+           "requested)\n",
+           (unsigned long)arena->used, (unsigned long)arena->capacity,
+           (unsigned long)size);
+    return NULL;
+  }
+  arena->used = start + size;
+  if (arena->used > arena->peak)
+    arena->peak = arena->used;
+  return arena->base + start;
+}
+
+void *arena_alloc_zeroed(Arena *arena, size_t size) {
+  void *memory = arena_alloc(arena, size);
+  if (memory)
+    memset(memory, 0, size);
+  return memory;
+}
+
+void arena_reset(Arena *arena) { arena->used = 0; }
+
+void arena_destroy(Arena *arena) {
+  mem_free(arena->base);
+  arena->base = NULL;
+  arena->capacity = 0;
+  arena->used = 0;
+}
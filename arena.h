@@ -0,0 +1,30 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+// Linear allocator over one block of memory. Allocations are bumped from the
+// front and released all at once with arena_reset.
+typedef struct {
+  unsigned char *base;
+  size_t capacity;
+  size_t used;
+  size_t peak; // Highest "used" seen since init
+} Arena;
+
+// Function declarations
+int arena_init(Arena *arena, size_t capacity);
+void *arena_alloc(Arena *arena, size_t size);
+void *arena_alloc_zeroed(Arena *arena, size_t size);
+void arena_reset(Arena *arena);
+void arena_destroy(Arena *arena);
+
+// Game-lifetime arena: entity stores and anything that lives until exit
+extern Arena game_arena;
+// Per-frame scratch arena: reset at the start of every tick
+extern Arena frame_arena;
+
+#define GAME_ARENA_SIZE (4 * 1024 * 1024)
+#define FRAME_ARENA_SIZE (1 * 1024 * 1024)
+
+#endif
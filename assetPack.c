@@ -0,0 +1,146 @@
+#define _POSIX_C_SOURCE 200112L // mmap under -std=c99
+
+#include "assetPack.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef VV_EMBEDDED_ASSETS
+// Linked in by assetPackEmbed.S
+extern const Uint8 vv_asset_pack[];
+extern const Uint8 vv_asset_pack_end[];
+
+// The embedded pack is never mapped
+static void unmap_file(AssetPack *pack) { (void)pack; }
+#elif defined(_WIN32)
+static int map_file(AssetPack *pack, const char *path) {
+  HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE)
+    return 0;
+  LARGE_INTEGER size;
+  HANDLE mapping = NULL;
+  const Uint8 *data = NULL;
+  if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+    mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (mapping)
+    data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  // The view keeps the mapping and the file alive
+  if (mapping)
+    CloseHandle(mapping);
+  CloseHandle(file);
+  if (!data)
+    return 0;
+  pack->data = data;
+  pack->size = (size_t)size.QuadPart;
+  pack->mapping = (void *)data;
+  return 1;
+}
+
+static void unmap_file(AssetPack *pack) { UnmapViewOfFile(pack->mapping); }
+#else
+static int map_file(AssetPack *pack, const char *path) {
+  int file = open(path, O_RDONLY);
+  if (file < 0)
+    return 0;
+  struct stat info;
+  void *data = MAP_FAILED;
+  if (fstat(file, &info) == 0 && info.st_size > 0)
+    data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+  close(file); // The mapping stays valid
+  if (data == MAP_FAILED)
+    return 0;
+  pack->data = data;
+  pack->size = (size_t)info.st_size;
+  pack->mapping = data;
+  return 1;
+}
+
+static void unmap_file(AssetPack *pack) {
+  munmap(pack->mapping, pack->size);
+}
+#endif
+
+// Check the header and that every entry lies inside the pack
+static int read_index(AssetPack *pack) {
+  const AssetPackHeader *header = (const AssetPackHeader *)pack->data;
+  if (pack->size < sizeof(*header) || header->magic != ASSET_PACK_MAGIC ||
+      header->version != ASSET_PACK_VERSION)
+    return 0;
+  if (header->count > (pack->size - sizeof(*header)) / sizeof(AssetPackEntry))
+    return 0;
+  const AssetPackEntry *entries = (const AssetPackEntry *)(header + 1);
+  for (Uint32 i = 0; i < header->count; i++) {
+    if (entries[i].offset > pack->size ||
+        entries[i].size > pack->size - entries[i].offset ||
+        entries[i].name[ASSET_NAME_LENGTH - 1] != '\0')
+      return 0;
+  }
+  pack->entries = entries;
+  pack->count = header->count;
+  return 1;
+}
+
+// Open the pack: the one linked into the executable when built with
+// EMBED_ASSETS=1, else file_name next to the executable. Returns 0 when
+// there is none, in which case every asset is read from loose files.
+int asset_pack_open(AssetPack *pack, const char *file_name) {
+  memset(pack, 0, sizeof(*pack));
+  // Without a base path, fall back to the working directory
+  pack->base_path = SDL_GetBasePath();
+#ifdef VV_EMBEDDED_ASSETS
+  (void)file_name;
+  pack->data = vv_asset_pack;
+  pack->size = (size_t)(vv_asset_pack_end - vv_asset_pack);
+#else
+  char path[1024];
+  snprintf(path, sizeof(path), "%s%s", pack->base_path ? pack->base_path : "",
+           file_name);
+  if (!map_file(pack, path)) {
+    printf("No asset pack at %s, using loose files\n", path);
+    return 0;
+  }
+#endif
+  if (!read_index(pack)) {
+    printf("Warning: Asset pack is damaged or out of date, using loose "
+           "files\n");
+    if (pack->mapping)
+      unmap_file(pack);
+    pack->data = NULL;
+    pack->size = 0;
+    pack->mapping = NULL;
+    return 0;
+  }
+  printf("Asset pack: %u assets, %lu bytes\n", pack->count,
+         (unsigned long)pack->size);
+  return 1;
+}
+
+// A read-only stream over one asset, or NULL when it exists nowhere. Valid
+// until the pack is closed.
+SDL_RWops *asset_pack_open_rw(AssetPack *pack, const char *name) {
+  for (Uint32 i = 0; i < pack->count; i++) {
+    const AssetPackEntry *entry = &pack->entries[i];
+    if (strcmp(entry->name, name) == 0)
+      return SDL_RWFromConstMem(pack->data + entry->offset, (int)entry->size);
+  }
+  char path[1024];
+  snprintf(path, sizeof(path), "%s%s", pack->base_path ? pack->base_path : "",
+           name);
+  return SDL_RWFromFile(path, "rb");
+}
+
+void asset_pack_close(AssetPack *pack) {
+  if (pack->mapping)
+    unmap_file(pack);
+  SDL_free(pack->base_path);
+  memset(pack, 0, sizeof(*pack));
+}
@@ -0,0 +1,45 @@
+#ifndef ASSETPACK_H
+#define ASSETPACK_H
+
+#include <SDL2/SDL.h>
+
+// Pack file layout: a header, the index, then every asset's bytes starting
+// on an ASSET_PACK_ALIGN boundary. Little-endian, like every target.
+#define ASSET_PACK_MAGIC 0x4B505656 // "VVPK"
+#define ASSET_PACK_VERSION 1
+#define ASSET_PACK_ALIGN 64
+#define ASSET_NAME_LENGTH 48
+
+typedef struct {
+  Uint32 magic;
+  Uint32 version;
+  Uint32 count; // Index entries following the header
+  Uint32 reserved;
+} AssetPackHeader;
+
+typedef struct {
+  char name[ASSET_NAME_LENGTH]; // File name the asset was packed from
+  Uint32 offset;                // From the start of the pack
+  Uint32 size;
+  Uint32 reserved[2];
+} AssetPackEntry;
+
+// The pack as the game sees it: mapped read-only (or linked into the
+// executable), so opening an asset is an index lookup and reading it is a
+// copy out of memory the OS pages in on demand. Assets missing from the
+// pack are read from loose files next to the executable.
+typedef struct {
+  const Uint8 *data;
+  size_t size;
+  const AssetPackEntry *entries;
+  Uint32 count;
+  char *base_path; // Directory of the executable, from SDL_GetBasePath
+  void *mapping;   // Platform handle to unmap, NULL when not mapped
+} AssetPack;
+
+// Function declarations
+int asset_pack_open(AssetPack *pack, const char *file_name);
+SDL_RWops *asset_pack_open_rw(AssetPack *pack, const char *name);
+void asset_pack_close(AssetPack *pack);
+
+#endif
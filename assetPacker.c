@@ -0,0 +1,102 @@
+// Builds the asset pack: assetPacker OUTPUT FILE...
+// Each file is stored under its name without the directory.
+#include "assetPack.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *base_name(const char *path) {
+  const char *name = path;
+  for (const char *c = path; *c; c++) {
+    if (*c == '/' || *c == '\\')
+      name = c + 1;
+  }
+  return name;
+}
+
+static Uint32 align_up(Uint32 offset) {
+  return (offset + ASSET_PACK_ALIGN - 1) & ~(Uint32)(ASSET_PACK_ALIGN - 1);
+}
+
+static int write_padding(FILE *out, Uint32 from, Uint32 to) {
+  static const Uint8 zeros[ASSET_PACK_ALIGN];
+  return to == from || fwrite(zeros, 1, to - from, out) == to - from;
+}
+
+int main(int argc, char *argv[]) {
+  if (argc < 3) {
+    printf("Usage: %s OUTPUT FILE...\n", argv[0]);
+    return 1;
+  }
+  Uint32 count = (Uint32)(argc - 2);
+  AssetPackEntry *entries = calloc(count, sizeof(AssetPackEntry));
+  if (!entries) {
+    printf("Error: Out of memory\n");
+    return 1;
+  }
+
+  // Lay out the blobs after the index
+  Uint32 offset =
+      align_up(sizeof(AssetPackHeader) + count * sizeof(AssetPackEntry));
+  for (Uint32 i = 0; i < count; i++) {
+    const char *path = argv[i + 2];
+    const char *name = base_name(path);
+    if (strlen(name) >= ASSET_NAME_LENGTH) {
+      printf("Error: Asset name too long: %s\n", name);
+      return 1;
+    }
+    FILE *file = fopen(path, "rb");
+    if (!file || fseek(file, 0, SEEK_END) != 0) {
+      printf("Error: Could not read %s\n", path);
+      return 1;
+    }
+    long size = ftell(file);
+    fclose(file);
+    if (size < 0) {
+      printf("Error: Could not read %s\n", path);
+      return 1;
+    }
+    strcpy(entries[i].name, name);
+    entries[i].offset = offset;
+    entries[i].size = (Uint32)size;
+    offset = align_up(offset + (Uint32)size);
+  }
+
+  FILE *out = fopen(argv[1], "wb");
+  if (!out) {
+    printf("Error: Could not create %s\n", argv[1]);
+    return 1;
+  }
+  AssetPackHeader header = {ASSET_PACK_MAGIC, ASSET_PACK_VERSION, count, 0};
+  Uint32 written = sizeof(header) + count * sizeof(AssetPackEntry);
+  int ok = fwrite(&header, sizeof(header), 1, out) == 1 &&
+           fwrite(entries, sizeof(AssetPackEntry), count, out) == count;
+
+  static Uint8 buffer[64 * 1024];
+  for (Uint32 i = 0; ok && i < count; i++) {
+    ok = write_padding(out, written, entries[i].offset);
+    written = entries[i].offset;
+    FILE *file = fopen(argv[i + 2], "rb");
+    Uint32 left = entries[i].size;
+    while (ok && file && left > 0) {
+      size_t chunk = left < sizeof(buffer) ? left : sizeof(buffer);
+      ok = fread(buffer, 1, chunk, file) == chunk &&
+           fwrite(buffer, 1, chunk, out) == chunk;
+      left -= (Uint32)chunk;
+    }
+    ok = ok && file;
+    if (file)
+      fclose(file);
+    written += entries[i].size;
+    printf("  %-24s %8u bytes at %u\n", entries[i].name, entries[i].size,
+           entries[i].offset);
+  }
+  if (fclose(out) != 0 || !ok) {
+    printf("Error: Could not write %s\n", argv[1]);
+    remove(argv[1]);
+    return 1;
+  }
+  free(entries);
+  printf("Packed %u assets into %s (%u bytes)\n", count, argv[1], written);
+  return 0;
+}
@@ -0,0 +1,345 @@
+#include "audio.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+// Merged triggers play at most this much louder than a single one
+#define MAX_MERGE_GAIN 2.0f
+
+// This many underruns within the window make the buffer grow
+#define UNDERRUN_WINDOW_MS 2000
+#define UNDERRUN_LIMIT 3
+
+static void run_commands(VoiceManager *audio);
+
+// Runs on the audio thread after SDL_mixer has mixed each buffer. A
+// callback arriving more than two buffers after the previous one means the
+// device ran dry in between.
+static void SDLCALL audio_postmix(void *data, Uint8 *stream, int len) {
+  VoiceManager *audio = data;
+  Uint64 start = SDL_GetPerformanceCounter();
+  if (audio->last_callback &&
+      start - audio->last_callback > audio->callback_period * 2) {
+    SDL_AtomicAdd(&audio->underruns, 1);
+  }
+  audio->last_callback = start;
+  SDL_AtomicAdd(&audio->callbacks, 1);
+  run_commands(audio);
+  if (audio->software_mix)
+    sfx_mixer_mix(&audio->mixer, (Sint16 *)stream, len / 4);
+
+  int elapsed_us = (int)((SDL_GetPerformanceCounter() - start) * 1000000 /
+                         SDL_GetPerformanceFrequency());
+  SDL_AtomicSet(&audio->callback_us, elapsed_us);
+  if (elapsed_us > SDL_AtomicGet(&audio->callback_peak_us))
+    SDL_AtomicSet(&audio->callback_peak_us, elapsed_us);
+}
+
+static int open_device(VoiceManager *audio, int rate, int buffer_frames) {
+  if (Mix_OpenAudio(rate, MIX_DEFAULT_FORMAT, 2, buffer_frames) < 0) {
+    printf("SDL_mixer could not initialize! SDL_mixer Error: %s\n",
+           Mix_GetError());
+    return 0;
+  }
+  int frequency = rate, channels = 2;
+  Uint16 format;
+  Mix_QuerySpec(&frequency, &format, &channels);
+  if (audio->software_mix && (format != AUDIO_S16SYS || channels != 2)) {
+    printf("Warning: Software mixer needs 16-bit stereo, using SDL_mixer\n");
+    audio->software_mix = 0;
+  }
+  audio->mixer.rate = frequency;
+  audio->stats.rate = frequency;
+  audio->stats.buffer_frames = buffer_frames;
+  audio->callback_period = SDL_GetPerformanceFrequency() * buffer_frames /
+                           (frequency > 0 ? frequency : rate);
+  audio->last_callback = 0;
+  audio->window_start = SDL_GetTicks();
+  audio->window_underruns = SDL_AtomicGet(&audio->underruns);
+  for (int i = 0; i < AUDIO_VOICES; i++)
+    audio->voice_sound[i] = -1;
+  Mix_AllocateChannels(AUDIO_VOICES);
+  Mix_SetPostMix(audio_postmix, audio);
+  printf("Audio: %d Hz, %d frame buffer (%.1f ms)\n", frequency,
+         buffer_frames, buffer_frames * 1000.0f / frequency);
+  return 1;
+}
+
+// Set up the voice manager and open the device. rate and buffer_frames are
+// what gets asked for; SDL_mixer may settle on another rate.
+int audio_open(VoiceManager *audio, int rate, int buffer_frames,
+               int software_mix) {
+  memset(audio, 0, sizeof(*audio));
+  for (int i = 0; i < SOUND_COUNT; i++)
+    SDL_AtomicSet(&audio->pending[i], 0);
+  SDL_AtomicSet(&audio->callbacks, 0);
+  SDL_AtomicSet(&audio->underruns, 0);
+  SDL_AtomicSet(&audio->callback_us, 0);
+  SDL_AtomicSet(&audio->callback_peak_us, 0);
+  SDL_AtomicSet(&audio->played, 0);
+  SDL_AtomicSet(&audio->stolen, 0);
+  SDL_AtomicSet(&audio->dropped, 0);
+  audio_queue_init(&audio->commands);
+  audio->master_volume = MIX_MAX_VOLUME;
+  audio->mix_volume = MIX_MAX_VOLUME;
+  // Sized for the largest buffer so growing it never reallocates
+  audio->software_mix =
+      software_mix && sfx_mixer_init(&audio->mixer, rate, AUDIO_MAX_BUFFER);
+  if (!open_device(audio, rate, buffer_frames)) {
+    sfx_mixer_shutdown(&audio->mixer);
+    return 0;
+  }
+  audio->stats.software_mix = audio->software_mix;
+  return 1;
+}
+
+void audio_close(VoiceManager *audio) {
+  Mix_SetPostMix(NULL, NULL);
+  Mix_CloseAudio();
+  sfx_mixer_shutdown(&audio->mixer);
+  audio->software_mix = 0;
+  audio->music = NULL;
+}
+
+// Loop the background music
+void audio_play_music(VoiceManager *audio, Mix_Music *music) {
+  audio->music = music;
+  if (!music)
+    return;
+  Mix_PlayMusic(music, -1);
+  Mix_VolumeMusic(audio->master_volume);
+  if (audio->master_volume == 0)
+    Mix_PauseMusic();
+}
+
+// Underruns keep coming: trade latency for stability. Loaded chunks stay
+// valid because the rate and format don't change.
+static void grow_buffer(VoiceManager *audio) {
+  int buffer_frames = audio->stats.buffer_frames * 2;
+  printf("Warning: Audio underruns, growing the buffer from %d to %d "
+         "frames\n",
+         audio->stats.buffer_frames, buffer_frames);
+  Mix_SetPostMix(NULL, NULL);
+  Mix_CloseAudio();
+  if (!open_device(audio, audio->stats.rate, buffer_frames)) {
+    audio->music = NULL;
+    return;
+  }
+  audio_play_music(audio, audio->music);
+}
+
+// Returns 1 when the device had to be reopened
+static int watch_underruns(VoiceManager *audio) {
+  Uint32 now = SDL_GetTicks();
+  int underruns = SDL_AtomicGet(&audio->underruns);
+  audio->stats.callbacks = (Uint32)SDL_AtomicGet(&audio->callbacks);
+  audio->stats.underruns = (Uint32)underruns;
+  audio->stats.callback_ms = SDL_AtomicGet(&audio->callback_us) / 1000.0f;
+  audio->stats.callback_peak_ms =
+      SDL_AtomicGet(&audio->callback_peak_us) / 1000.0f;
+  audio->stats.played = (Uint32)SDL_AtomicGet(&audio->played);
+  audio->stats.stolen = (Uint32)SDL_AtomicGet(&audio->stolen);
+  audio->stats.dropped = (Uint32)SDL_AtomicGet(&audio->dropped);
+  audio->stats.mixer_voices = SDL_AtomicGet(&audio->mixer.mixed);
+  audio->stats.mixer_stolen = (Uint32)SDL_AtomicGet(&audio->mixer.stolen);
+
+  if (underruns - audio->window_underruns >= UNDERRUN_LIMIT &&
+      audio->stats.buffer_frames < AUDIO_MAX_BUFFER) {
+    grow_buffer(audio);
+    return 1;
+  }
+  if (now - audio->window_start >= UNDERRUN_WINDOW_MS) {
+    audio->window_start = now;
+    audio->window_underruns = underruns;
+  }
+  return 0;
+}
+
+// Register a sound. The class volume replaces the chunk volume so merged
+// triggers have room to play louder.
+void audio_set_sound(VoiceManager *audio, SoundId id, Mix_Chunk *chunk,
+                     int priority, int max_voices, int volume) {
+  SoundClass *sound = &audio->sounds[id];
+  sound->chunk = chunk;
+  sound->priority = priority;
+  sound->max_voices = max_voices;
+  sound->volume = volume;
+  if (chunk)
+    Mix_VolumeChunk(chunk, MIX_MAX_VOLUME);
+}
+
+// Safe from any thread; nothing is played until audio_update
+void audio_trigger(VoiceManager *audio, SoundId id) {
+  SDL_AtomicAdd(&audio->pending[id], 1);
+}
+
+// Channel to play sound id on, or -1. Takes the oldest voice of the same
+// sound when it is at its limit, then a free channel, then the oldest voice
+// of the lowest priority below it. Audio thread only.
+static int find_voice(VoiceManager *audio, int id) {
+  const SoundClass *sound = &audio->sounds[id];
+  int same_count = 0, oldest_same = -1, free_voice = -1, victim = -1;
+
+  for (int i = 0; i < AUDIO_VOICES; i++) {
+    if (audio->voice_sound[i] >= 0 && !Mix_Playing(i))
+      audio->voice_sound[i] = -1;
+    int playing = audio->voice_sound[i];
+    if (playing < 0) {
+      if (free_voice < 0)
+        free_voice = i;
+      continue;
+    }
+    if (playing == id) {
+      same_count++;
+      if (oldest_same < 0 ||
+          audio->voice_started[i] < audio->voice_started[oldest_same])
+        oldest_same = i;
+    } else if (audio->sounds[playing].priority < sound->priority) {
+      if (victim < 0 ||
+          audio->sounds[playing].priority <
+              audio->sounds[audio->voice_sound[victim]].priority ||
+          (audio->sounds[playing].priority ==
+               audio->sounds[audio->voice_sound[victim]].priority &&
+           audio->voice_started[i] < audio->voice_started[victim]))
+        victim = i;
+    }
+  }
+
+  if (same_count >= sound->max_voices) {
+    SDL_AtomicAdd(&audio->stolen, 1);
+    return oldest_same;
+  }
+  if (free_voice >= 0)
+    return free_voice;
+  if (victim >= 0) {
+    SDL_AtomicAdd(&audio->stolen, 1);
+    return victim;
+  }
+  return -1;
+}
+
+// Start one voice of a sound. gain already includes the class volume.
+static void play_sound(VoiceManager *audio, const AudioCommand *command) {
+  const SoundClass *sound = &audio->sounds[command->sound];
+  if (audio->software_mix) {
+    // No channel limit to manage; the mixer has voices to spare
+    sfx_mixer_start(&audio->mixer, sound->chunk,
+                    command->gain * audio->mix_volume / MIX_MAX_VOLUME,
+                    command->time);
+    SDL_AtomicAdd(&audio->played, 1);
+    return;
+  }
+
+  int voice = find_voice(audio, command->sound);
+  if (voice < 0) {
+    SDL_AtomicAdd(&audio->dropped, 1);
+    return;
+  }
+  int volume = (int)(command->gain * audio->mix_volume);
+  if (volume > MIX_MAX_VOLUME)
+    volume = MIX_MAX_VOLUME;
+  Mix_Volume(voice, volume);
+  if (Mix_PlayChannel(voice, sound->chunk, 0) < 0) {
+    SDL_AtomicAdd(&audio->dropped, 1);
+    return;
+  }
+  audio->voice_sound[voice] = command->sound;
+  audio->voice_started[voice] = SDL_GetTicks();
+  SDL_AtomicAdd(&audio->played, 1);
+}
+
+// Apply everything the main thread posted since the last buffer. SDL_mixer
+// calls the post-mix hook with the device lock already held, so the Mix_*
+// calls here never wait on anyone.
+static void run_commands(VoiceManager *audio) {
+  AudioCommand command;
+  while (audio_queue_pop(&audio->commands, &command)) {
+    switch (command.type) {
+    case AUDIO_CMD_PLAY:
+      play_sound(audio, &command);
+      break;
+    case AUDIO_CMD_STOP:
+      if (audio->software_mix) {
+        sfx_mixer_stop_all(&audio->mixer);
+      } else {
+        Mix_HaltChannel(-1);
+      }
+      for (int i = 0; i < AUDIO_VOICES; i++)
+        audio->voice_sound[i] = -1;
+      break;
+    case AUDIO_CMD_SET_VOLUME:
+      // Muted music is paused so it isn't decoded and mixed for nothing
+      audio->mix_volume = command.volume;
+      Mix_VolumeMusic(command.volume);
+      if (command.volume == 0) {
+        Mix_PauseMusic();
+      } else if (Mix_PausedMusic()) {
+        Mix_ResumeMusic();
+      }
+      break;
+    }
+  }
+}
+
+static void post(VoiceManager *audio, const AudioCommand *command) {
+  if (!audio_queue_push(&audio->commands, command))
+    SDL_AtomicAdd(&audio->dropped, 1);
+}
+
+// Silence every sound effect, e.g. when a new game starts
+void audio_stop_effects(VoiceManager *audio) {
+  AudioCommand command = {AUDIO_CMD_STOP, 0, 0, 0.0f, 0};
+  post(audio, &command);
+}
+
+// Turn this frame's triggers into play commands for the audio thread. Call
+// once per frame from the main thread; nothing here touches SDL_mixer
+// unless the device has to be reopened. Returns 1 when it was.
+int audio_update(VoiceManager *audio, int master_volume) {
+  Uint64 now = SDL_GetPerformanceCounter();
+  int reopened = watch_underruns(audio);
+
+  if (master_volume != audio->master_volume) {
+    audio->master_volume = master_volume;
+    AudioCommand command = {AUDIO_CMD_SET_VOLUME, 0, master_volume, 0.0f,
+                            now};
+    post(audio, &command);
+  }
+
+  for (int id = 0; id < SOUND_COUNT; id++) {
+    int count = SDL_AtomicSet(&audio->pending[id], 0);
+    if (count <= 0)
+      continue;
+    const SoundClass *sound = &audio->sounds[id];
+    audio->stats.triggered += count;
+    audio->stats.merged += count - 1;
+    if (!sound->chunk)
+      continue;
+
+    // Uncorrelated copies of a sound add up to about sqrt(n) times louder
+    float gain = sqrtf((float)count);
+    if (gain > MAX_MERGE_GAIN)
+      gain = MAX_MERGE_GAIN;
+    AudioCommand command = {AUDIO_CMD_PLAY, id, 0,
+                            sound->volume * gain / MIX_MAX_VOLUME, now};
+    post(audio, &command);
+  }
+  return reopened;
+}
+
+void audio_report(const VoiceManager *audio) {
+  if (audio->stats.triggered > 0) {
+    printf("Audio: %u triggers, %u voices, %u merged, %u stolen, "
+           "%u dropped\n",
+           audio->stats.triggered, audio->stats.played, audio->stats.merged,
+           audio->stats.stolen, audio->stats.dropped);
+  }
+  printf("Audio device: %d frame buffer, %u callbacks, %u underruns, "
+         "post-mix peak %.2f ms\n",
+         audio->stats.buffer_frames, audio->stats.callbacks,
+         audio->stats.underruns, audio->stats.callback_peak_ms);
+  if (audio->stats.software_mix) {
+    printf("Audio mixer: %d voices, %u stolen\n", SFX_MIXER_VOICES,
+           audio->stats.mixer_stolen);
+  }
+}
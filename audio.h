@@ -0,0 +1,97 @@
+#ifndef AUDIO_H
+#define AUDIO_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+#include "audioQueue.h"
+#include "sfxMixer.h"
+
+// Mixer channels the voice manager hands out
+#define AUDIO_VOICES 16
+
+// Device buffer sizes (sample frames)
+#define AUDIO_DEFAULT_BUFFER 2048
+#define AUDIO_LOW_LATENCY_BUFFER 256
+#define AUDIO_MAX_BUFFER 4096
+
+typedef enum { SOUND_SHOOT, SOUND_EXPLODE, SOUND_COUNT } SoundId;
+
+// How one kind of sound is played
+typedef struct {
+  Mix_Chunk *chunk;
+  int priority;   // Higher steals voices from lower
+  int max_voices; // Voices of this sound playing at once
+  int volume;     // 0-128 for a single trigger
+} SoundClass;
+
+typedef struct {
+  Uint32 triggered; // Triggers received
+  Uint32 played;    // Voices started
+  Uint32 merged;    // Triggers folded into another one from the same frame
+  Uint32 stolen;    // Voices cut short to make room
+  Uint32 dropped;   // Triggers that found no voice
+  int rate, buffer_frames; // Device in use
+  Uint32 callbacks;
+  Uint32 underruns;      // Callbacks that came over two buffers apart
+  float callback_ms;     // Time spent in the post-mix stage, last callback
+  float callback_peak_ms;
+  int software_mix;  // Sound effects go through the game's own mixer
+  int mixer_voices;  // Voices it mixed in the last callback
+  Uint32 mixer_stolen;
+} AudioStats;
+
+// Game-side voice manager in front of SDL_mixer. Triggers only bump a
+// counter, from any thread; once per frame all triggers of the same sound
+// become a single play command, louder the more there were. Commands reach
+// the audio thread through a lock-free ring and are carried out in the
+// post-mix hook, so neither gameplay nor the menus take the device lock. Each sound has a
+// priority and a voice limit, and when the channels run out the oldest
+// lower-priority voice is stolen, so a big wave costs a bounded number of
+// voices instead of saturating the mixer.
+typedef struct {
+  SoundClass sounds[SOUND_COUNT];
+  SDL_atomic_t pending[SOUND_COUNT]; // Triggers since the last update
+  AudioCommandQueue commands;        // Main thread to audio thread
+  int master_volume;                 // Last volume posted, main thread
+  AudioStats stats;
+
+  // Audio thread only
+  int voice_sound[AUDIO_VOICES]; // Sound on each channel, -1 = none
+  Uint32 voice_started[AUDIO_VOICES];
+  int mix_volume; // Master volume in effect
+  SDL_atomic_t played;
+  SDL_atomic_t stolen;
+  SDL_atomic_t dropped;
+
+  // Device. Opened with a configurable buffer; a post-mix hook on the audio
+  // thread watches callback timing, and when underruns keep coming the
+  // device is reopened with a buffer twice the size.
+  Mix_Music *music; // Restarted when the device is reopened
+  Uint64 callback_period; // Counter ticks per buffer
+  Uint64 last_callback;   // Audio thread only
+  SDL_atomic_t callbacks;
+  SDL_atomic_t underruns;
+  SDL_atomic_t callback_us;
+  SDL_atomic_t callback_peak_us;
+  Uint32 window_start;   // Start of the current underrun window (ms)
+  int window_underruns; // Underrun count when the window started
+
+  // Optional software mixer for sound effects, run inside the post-mix hook
+  // so the callback timing covers it. SDL_mixer then only plays music.
+  SfxMixer mixer;
+  int software_mix;
+} VoiceManager;
+
+// Function declarations
+int audio_open(VoiceManager *audio, int rate, int buffer_frames,
+               int software_mix);
+void audio_close(VoiceManager *audio);
+void audio_play_music(VoiceManager *audio, Mix_Music *music);
+void audio_set_sound(VoiceManager *audio, SoundId id, Mix_Chunk *chunk,
+                     int priority, int max_voices, int volume);
+void audio_trigger(VoiceManager *audio, SoundId id);
+void audio_stop_effects(VoiceManager *audio);
+int audio_update(VoiceManager *audio, int master_volume);
+void audio_report(const VoiceManager *audio);
+
+#endif
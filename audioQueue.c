@@ -0,0 +1,35 @@
+#include "audioQueue.h"
+
+// Indices run over twice the ring so a full ring differs from an empty one
+#define INDEX_MASK (AUDIO_QUEUE_SIZE * 2 - 1)
+
+void audio_queue_init(AudioCommandQueue *queue) {
+  SDL_AtomicSet(&queue->head, 0);
+  SDL_AtomicSet(&queue->tail, 0);
+}
+
+// Producer side. Returns 0 when the ring is full.
+int audio_queue_push(AudioCommandQueue *queue, const AudioCommand *command) {
+  int head = SDL_AtomicGet(&queue->head);
+  int tail = SDL_AtomicGet(&queue->tail);
+  SDL_MemoryBarrierAcquire();
+  if (((head - tail) & INDEX_MASK) == AUDIO_QUEUE_SIZE)
+    return 0;
+  queue->commands[head & (AUDIO_QUEUE_SIZE - 1)] = *command;
+  SDL_MemoryBarrierRelease();
+  SDL_AtomicSet(&queue->head, (head + 1) & INDEX_MASK);
+  return 1;
+}
+
+// Consumer side. Returns 0 when there is nothing to read.
+int audio_queue_pop(AudioCommandQueue *queue, AudioCommand *command) {
+  int tail = SDL_AtomicGet(&queue->tail);
+  int head = SDL_AtomicGet(&queue->head);
+  SDL_MemoryBarrierAcquire();
+  if (head == tail)
+    return 0;
+  *command = queue->commands[tail & (AUDIO_QUEUE_SIZE - 1)];
+  SDL_MemoryBarrierRelease();
+  SDL_AtomicSet(&queue->tail, (tail + 1) & INDEX_MASK);
+  return 1;
+}
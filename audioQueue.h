@@ -0,0 +1,37 @@
+#ifndef AUDIOQUEUE_H
+#define AUDIOQUEUE_H
+
+#include <SDL2/SDL.h>
+
+// Commands in flight at once; a power of two
+#define AUDIO_QUEUE_SIZE 256
+
+typedef enum {
+  AUDIO_CMD_PLAY,      // Start sound at gain
+  AUDIO_CMD_STOP,      // Silence every sound effect
+  AUDIO_CMD_SET_VOLUME // Master volume (0-128) for effects and music
+} AudioCommandType;
+
+typedef struct {
+  AudioCommandType type;
+  int sound;
+  int volume;
+  float gain;
+  Uint64 time; // Counter time the command was posted
+} AudioCommand;
+
+// Single-producer, single-consumer ring. The main thread posts, the audio
+// callback drains, and neither ever waits on the other: each side only
+// writes its own index, published with a release barrier after the slot.
+typedef struct {
+  AudioCommand commands[AUDIO_QUEUE_SIZE];
+  SDL_atomic_t head; // Next slot to write, producer only
+  SDL_atomic_t tail; // Next slot to read, consumer only
+} AudioCommandQueue;
+
+// Function declarations
+void audio_queue_init(AudioCommandQueue *queue);
+int audio_queue_push(AudioCommandQueue *queue, const AudioCommand *command);
+int audio_queue_pop(AudioCommandQueue *queue, AudioCommand *command);
+
+#endif
@@ -0,0 +1,181 @@
+#include "background.h"
+#include "memtrack.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+void initialize_background(Background *background) {
+  background->texture = NULL;
+  background->width = 0;
+  background->height = 0;
+  background->blue = -1;
+}
+
+// Dynamic background color based on score (blue space theme)
+static int score_tier_blue(int score) {
+  if (score >= 10000)
+    return 200; // Light blue
+  if (score >= 8000)
+    return 150; // Medium blue
+  if (score >= 6000)
+    return 100; // Dark blue
+  if (score >= 4000)
+    return 50; // Very dark blue
+  if (score >= 2000)
+    return 25; // Deep blue
+  return 0;    // Black
+}
+
+static void render_background(Background *background, SDL_Renderer *renderer,
+                              RenderBatch *batch) {
+  SDL_SetRenderDrawColor(renderer, 0, 0, background->blue, 255);
+  SDL_RenderClear(renderer);
+
+  SDL_Color star_color = {255, 255, 255, 255};
+  for (int i = 0; i < BACKGROUND_STAR_COUNT; i++) {
+    render_batch_fill_rect(batch, background->star_x[i], background->star_y[i],
+                           2, 2, star_color);
+  }
+  render_batch_flush(batch);
+}
+
+// Regenerate stars if window size changed
+static int place_stars(Background *background, int window_w, int window_h) {
+  int resized = window_w != background->width || window_h != background->height;
+  if (resized) {
+    for (int i = 0; i < BACKGROUND_STAR_COUNT; i++) {
+      background->star_x[i] = rand() % window_w;
+      background->star_y[i] = rand() % window_h;
+    }
+  }
+  return resized;
+}
+
+void draw_background(Background *background, SDL_Renderer *renderer,
+                     RenderBatch *batch, int window_w, int window_h,
+                     int score) {
+  int blue = score_tier_blue(score);
+  int resized = place_stars(background, window_w, window_h);
+
+  if (!SDL_RenderTargetSupported(renderer)) {
+    background->width = window_w;
+    background->height = window_h;
+    background->blue = blue;
+    render_background(background, renderer, batch);
+    return;
+  }
+
+  if (resized || !background->texture) {
+    cleanup_background(background);
+    background->texture =
+        SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                          SDL_TEXTUREACCESS_TARGET, window_w, window_h);
+    if (!background->texture) {
+      printf("Warning: Could not create background texture: %s\n",
+             SDL_GetError());
+      return;
+    }
+    SDL_SetTextureBlendMode(background->texture, SDL_BLENDMODE_NONE);
+    memtrack_note_texture(window_w, window_h, 4);
+    background->width = window_w;
+    background->height = window_h;
+    background->blue = -1;
+  }
+
+  if (blue != background->blue) {
+    background->blue = blue;
+    SDL_Texture *previous_target = SDL_GetRenderTarget(renderer);
+    SDL_SetRenderTarget(renderer, background->texture);
+    render_background(background, renderer, batch);
+    SDL_SetRenderTarget(renderer, previous_target);
+  }
+
+  SDL_RenderCopy(renderer, background->texture, NULL, NULL);
+}
+
+// The same background as render commands, for the software rasterizer where
+// filling it again is as cheap as copying a cached texture
+void emit_background(Background *background, RenderCommandBuffer *commands,
+                     int window_w, int window_h, int score) {
+  if (place_stars(background, window_w, window_h)) {
+    cleanup_background(background);
+    background->width = window_w;
+    background->height = window_h;
+  }
+  int blue = score_tier_blue(score);
+  emit_quad(commands, RENDER_LAYER_BACKGROUND, 0, 0, window_w, window_h,
+            (SDL_Color){0, 0, blue, 255});
+  SDL_Color star_color = {255, 255, 255, 255};
+  for (int i = 0; i < BACKGROUND_STAR_COUNT; i++) {
+    emit_quad(commands, RENDER_LAYER_STARS, background->star_x[i],
+              background->star_y[i], 2, 2, star_color);
+  }
+}
+
+// The cached texture lost its contents, or with device_lost the texture
+// itself; the next draw_background renders it again. Called with the other
+// renderer texture resets, so the whole frame comes back together.
+void reset_background(Background *background, int device_lost) {
+  if (device_lost)
+    cleanup_background(background);
+  background->blue = -1;
+}
+
+void cleanup_background(Background *background) {
+  if (background->texture) {
+    SDL_DestroyTexture(background->texture);
+    memtrack_forget_texture(background->width, background->height, 4);
+    background->texture = NULL;
+  }
+}
+
+int initialize_starfield(Starfield *starfield, Arena *arena, int star_count) {
+  starfield->x = arena_alloc(arena, sizeof(float) * star_count);
+  starfield->y = arena_alloc(arena, sizeof(float) * star_count);
+  starfield->speed = arena_alloc(arena, sizeof(float) * star_count);
+  starfield->size = arena_alloc(arena, sizeof(float) * star_count);
+  starfield->bright = arena_alloc(arena, sizeof(Uint8) * star_count);
+  if (!starfield->x || !starfield->y || !starfield->speed ||
+      !starfield->size || !starfield->bright) {
+    starfield->count = 0;
+    starfield->active = 0;
+    return 0;
+  }
+  starfield->count = star_count;
+  starfield->active = star_count;
+
+  // Far layers are small, dim and slow; near layers big, bright and fast
+  static const float layer_speed[STARFIELD_LAYERS] = {0.01f, 0.03f, 0.08f};
+  static const float layer_size[STARFIELD_LAYERS] = {1.0f, 2.0f, 3.0f};
+  static const Uint8 layer_bright[STARFIELD_LAYERS] = {110, 180, 255};
+  for (int i = 0; i < star_count; i++) {
+    // Roughly half the stars in the far layer, a sixth in the near one
+    int roll = rand() % 6;
+    int layer = (roll < 3) ? 0 : (roll < 5) ? 1 : 2;
+    starfield->x[i] = (rand() % 10000) / 10000.0f;
+    starfield->y[i] = (rand() % 10000) / 10000.0f;
+    starfield->speed[i] = layer_speed[layer];
+    starfield->size[i] = layer_size[layer];
+    starfield->bright[i] = layer_bright[layer];
+  }
+  return 1;
+}
+
+// Branch-free so the compiler can vectorize the whole pass
+void update_starfield(Starfield *starfield, float frame_time) {
+  float *restrict y = starfield->y;
+  const float *restrict speed = starfield->speed;
+  for (int i = 0; i < starfield->active; i++) {
+    float moved = y[i] + speed[i] * frame_time;
+    y[i] = moved - (moved >= 1.0f ? 1.0f : 0.0f);
+  }
+}
+
+void draw_starfield(Starfield *starfield, RenderCommandBuffer *commands,
+                    int window_w, int window_h) {
+  for (int i = 0; i < starfield->active; i++) {
+    Uint8 level = starfield->bright[i];
+    emit_quad(commands, RENDER_LAYER_STARS, starfield->x[i] * window_w,
+              starfield->y[i] * window_h, starfield->size[i],
+              starfield->size[i], (SDL_Color){level, level, level, 255});
+  }
+}
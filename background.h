@@ -0,0 +1,53 @@
+#ifndef BACKGROUND_H
+#define BACKGROUND_H
+
+#include "arena.h"
+#include "renderBatch.h"
+#include "renderCommands.h"
+#include <SDL2/SDL.h>
+
+#define BACKGROUND_STAR_COUNT 100
+#define STARFIELD_LAYERS 3
+// Most stars --stars accepts. Every star is a command the frame sorts with
+// scratch memory from the frame arena.
+#define STARFIELD_MAX_STARS 20000
+
+// Static background (score-tier colour plus the classic 2x2 stars) cached in
+// a texture. It is only re-rendered when the window size or the colour tier
+// changes.
+typedef struct {
+  SDL_Texture *texture;
+  int width, height;
+  int blue; // Score-tier blue the cached texture was built with
+  float star_x[BACKGROUND_STAR_COUNT];
+  float star_y[BACKGROUND_STAR_COUNT];
+} Background;
+
+// Optional parallax starfield. Positions are normalized to the window so a
+// resize costs nothing; all stars move in one pass over the arrays.
+typedef struct {
+  float *x, *y;  // 0..1 across the window
+  float *speed;  // Window heights per second
+  float *size;   // Pixels
+  Uint8 *bright; // Grey level
+  int count;
+  int active; // Stars moved and drawn; the order is random, so any prefix
+              // is an even thinning of the field
+} Starfield;
+
+// Function declarations
+void initialize_background(Background *background);
+void draw_background(Background *background, SDL_Renderer *renderer,
+                     RenderBatch *batch, int window_w, int window_h,
+                     int score);
+void emit_background(Background *background, RenderCommandBuffer *commands,
+                     int window_w, int window_h, int score);
+void reset_background(Background *background, int device_lost);
+void cleanup_background(Background *background);
+
+int initialize_starfield(Starfield *starfield, Arena *arena, int star_count);
+void update_starfield(Starfield *starfield, float frame_time);
+void draw_starfield(Starfield *starfield, RenderCommandBuffer *commands,
+                    int window_w, int window_h);
+
+#endif
@@ -4,9 +4,9 @@
 
 echo "Building Windows release..."
 
-# Clean and build Windows version
+# Clean and build Windows version, with the assets linked into the exe
 make clean
-make windows
+make windows EMBED_ASSETS=1
 
 # Create or update Windows release directory
 mkdir -p VoidVanguard-Windows
@@ -14,21 +14,20 @@ mkdir -p VoidVanguard-Windows
 # Copy executable and required files
 cp VoidVanguard.exe VoidVanguard-Windows/
 cp /home/matomas/SDL2-windows/x86_64-w64-mingw32/bin/SDL2.dll /home/matomas/SDL2-windows/x86_64-w64-mingw32/bin/SDL2_mixer.dll VoidVanguard-Windows/
-cp *.wav *.mp3 VoidVanguard-Windows/
 
 echo "Windows release ready in VoidVanguard-Windows/"
 
 echo "Building Linux release..."
 
-# Clean and build Linux version
+# Clean and build Linux version and its asset pack
 make clean
-make
+make all pack
 
 # Create Linux release directory
 mkdir -p VoidVanguard-Linux
 
 # Copy executable and assets
 cp VoidVanguard VoidVanguard-Linux/
-cp *.wav *.mp3 VoidVanguard-Linux/
+cp assets.pak VoidVanguard-Linux/
 
 echo "Linux release ready in VoidVanguard-Linux/"
\ No newline at end of file
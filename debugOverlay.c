@@ -0,0 +1,103 @@
+#include "debugOverlay.h"
+#include "text.h"
+#include <stdio.h>
+
+#define OVERLAY_X 10.0f
+#define OVERLAY_Y 40.0f
+#define OVERLAY_LINE_HEIGHT 14.0f
+#define OVERLAY_SCALE 1.0f
+#define OVERLAY_LINES 9
+#define HISTOGRAM_HEIGHT 40
+#define HISTOGRAM_BAR_MS 2 // Latency buckets per bar
+#define HISTOGRAM_BAR_WIDTH 5
+
+static void overlay_line(SDL_Renderer *renderer, int line, const char *text) {
+  SDL_Color color = {255, 255, 0, 255};
+  draw_text(renderer, text, OVERLAY_X, OVERLAY_Y + line * OVERLAY_LINE_HEIGHT,
+            color, OVERLAY_SCALE);
+}
+
+// Latency histogram as a bar chart, tallest bar at full height
+static void draw_latency_bars(SDL_Renderer *renderer,
+                              const LatencyHistogram *latency, int top) {
+  Uint32 bars[LATENCY_BUCKETS / HISTOGRAM_BAR_MS];
+  int bar_count = LATENCY_BUCKETS / HISTOGRAM_BAR_MS;
+  Uint32 largest = 0;
+  for (int i = 0; i < bar_count; i++) {
+    bars[i] = 0;
+    for (int j = 0; j < HISTOGRAM_BAR_MS; j++)
+      bars[i] += latency->buckets[i * HISTOGRAM_BAR_MS + j];
+    if (bars[i] > largest)
+      largest = bars[i];
+  }
+  if (largest == 0)
+    return;
+
+  SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255);
+  for (int i = 0; i < bar_count; i++) {
+    if (bars[i] == 0)
+      continue;
+    int height = (int)((Uint64)bars[i] * HISTOGRAM_HEIGHT / largest);
+    if (height < 1)
+      height = 1;
+    SDL_Rect bar = {(int)OVERLAY_X + i * HISTOGRAM_BAR_WIDTH,
+                    top + HISTOGRAM_HEIGHT - height, HISTOGRAM_BAR_WIDTH - 1,
+                    height};
+    SDL_RenderFillRect(renderer, &bar);
+  }
+}
+
+// Frame timing and quality telemetry, drawn on top of everything
+void draw_debug_overlay(SDL_Renderer *renderer, const DebugStats *stats) {
+  char text[64];
+  int line = 0;
+
+  SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+  SDL_SetRenderDrawColor(renderer, 0, 0, 0, 160);
+  SDL_Rect panel = {(int)OVERLAY_X - 4, (int)OVERLAY_Y - 4, 420,
+                    (int)(OVERLAY_LINES * OVERLAY_LINE_HEIGHT) +
+                        HISTOGRAM_HEIGHT + 12};
+  SDL_RenderFillRect(renderer, &panel);
+  SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+
+  snprintf(text, sizeof(text), "FPS %.0f  P95 %.1f/%.1f MS", stats->fps,
+           stats->frame_p95_ms, stats->budget_ms);
+  overlay_line(renderer, line++, text);
+  snprintf(text, sizeof(text), "QUALITY %d/%d", stats->quality_level,
+           stats->quality_levels - 1);
+  overlay_line(renderer, line++, text);
+  snprintf(text, sizeof(text), "ENEMIES %d  MOTION MERGED %d",
+           stats->enemies, stats->motion_merged);
+  overlay_line(renderer, line++, text);
+  snprintf(text, sizeof(text), "CMDS %d CULLED %d CALLS %d", stats->commands,
+           stats->culled, stats->draw_calls);
+  overlay_line(renderer, line++, text);
+  snprintf(text, sizeof(text), "%s %.0f ERR %.2f PEAK %.2f MS", stats->pacing,
+           stats->pacing_rate, stats->pacing_error_ms,
+           stats->pacing_worst_ms);
+  overlay_line(renderer, line++, text);
+  snprintf(text, sizeof(text), "LATENCY P50 %d P95 %d P99 %d MS",
+           latency_percentile(stats->latency, 50),
+           latency_percentile(stats->latency, 95),
+           latency_percentile(stats->latency, 99));
+  overlay_line(renderer, line++, text);
+  snprintf(text, sizeof(text), "VOICES %u MERGED %u STOLEN %u DROPPED %u",
+           stats->audio->played, stats->audio->merged, stats->audio->stolen,
+           stats->audio->dropped);
+  overlay_line(renderer, line++, text);
+  snprintf(text, sizeof(text), "AUDIO %d BUF %d UNDERRUNS %u",
+           stats->audio->rate, stats->audio->buffer_frames,
+           stats->audio->underruns);
+  overlay_line(renderer, line++, text);
+  if (stats->audio->software_mix) {
+    snprintf(text, sizeof(text), "SOFT VOICES %d STOLEN %u CB %.2f MS",
+             stats->audio->mixer_voices, stats->audio->mixer_stolen,
+             stats->audio->callback_ms);
+  } else {
+    snprintf(text, sizeof(text), "CALLBACK %.2f PEAK %.2f MS",
+             stats->audio->callback_ms, stats->audio->callback_peak_ms);
+  }
+  overlay_line(renderer, line++, text);
+  draw_latency_bars(renderer, stats->latency,
+                    (int)(OVERLAY_Y + line * OVERLAY_LINE_HEIGHT) + 4);
+}
@@ -0,0 +1,31 @@
+#ifndef DEBUGOVERLAY_H
+#define DEBUGOVERLAY_H
+
+#include "audio.h"
+#include "latency.h"
+#include <SDL2/SDL.h>
+
+// Numbers shown by the F3 overlay, gathered by the main loop each frame
+typedef struct {
+  float fps;
+  float frame_p95_ms; // Frame work time, 95th percentile
+  float budget_ms;
+  int quality_level;
+  int quality_levels;
+  int enemies;
+  int motion_merged; // Mouse motion events coalesced this frame
+  int commands;
+  int culled;
+  int draw_calls;
+  const char *pacing; // Frame pacing mode
+  float pacing_rate;  // Hz aimed for, 0 when uncapped
+  float pacing_error_ms;
+  float pacing_worst_ms;
+  const LatencyHistogram *latency; // Input-to-present latency
+  const AudioStats *audio;
+} DebugStats;
+
+// Function declarations
+void draw_debug_overlay(SDL_Renderer *renderer, const DebugStats *stats);
+
+#endif
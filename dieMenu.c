@@ -1,5 +1,5 @@
 #include "dieMenu.h"
-#include "enemy.h"
+#include "text.h"
 #include <SDL2/SDL.h>
 #include <stdio.h>
 #include <string.h>
@@ -118,377 +118,7 @@ void update_die_menu(DieMenu *menu, SDL_Event *event, int *game_running,
   }
 }
 
-// Get text width
-float get_text_width(const char *text, float scale) {
-  float width = 0.0f;
-  for (size_t i = 0; text[i] != '\0'; i++) {
-    char c = text[i];
-    if (c == ' ') {
-      width += 6 * scale;
-    } else {
-      width += 12 * scale;
-    }
-  }
-  return width;
-}
-
-// Clean text rendering for SCORE: and numbers
-void draw_text(SDL_Renderer *renderer, const char *text, float x, float y,
-                SDL_Color color, float scale) {
-  SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-
-  float current_x = x;
-  for (size_t i = 0; text[i] != '\0'; i++) {
-    char c = text[i];
-    if (c == ' ') {
-      current_x += 6 * scale;
-      continue;
-    }
-
-    // Only render characters we need: S, C, O, R, E, :, 0-9
-    if (c == 'S') {
-      SDL_Rect r1 = {current_x, y, 8 * scale, 2 * scale};
-      SDL_Rect r2 = {current_x, y + 4 * scale, 8 * scale, 2 * scale};
-      SDL_Rect r3 = {current_x, y + 8 * scale, 8 * scale, 2 * scale};
-      SDL_Rect r4 = {current_x, y, 2 * scale, 6 * scale};
-      SDL_Rect r5 = {current_x + 6 * scale, y + 4 * scale, 2 * scale,
-                      6 * scale};
-      SDL_RenderFillRect(renderer, &r1);
-      SDL_RenderFillRect(renderer, &r2);
-      SDL_RenderFillRect(renderer, &r3);
-      SDL_RenderFillRect(renderer, &r4);
-      SDL_RenderFillRect(renderer, &r5);
-    } else if (c == 'C') {
-      SDL_Rect r1 = {current_x, y, 8 * scale, 2 * scale};
-      SDL_Rect r2 = {current_x, y + 8 * scale, 8 * scale, 2 * scale};
-      SDL_Rect r3 = {current_x, y, 2 * scale, 10 * scale};
-      SDL_RenderFillRect(renderer, &r1);
-      SDL_RenderFillRect(renderer, &r2);
-      SDL_RenderFillRect(renderer, &r3);
-    } else if (c == 'O') {
-      SDL_Rect r1 = {current_x, y, 8 * scale, 2 * scale};
-      SDL_Rect r2 = {current_x, y + 8 * scale, 8 * scale, 2 * scale};
-      SDL_Rect r3 = {current_x, y, 2 * scale, 10 * scale};
-      SDL_Rect r4 = {current_x + 6 * scale, y, 2 * scale, 10 * scale};
-      SDL_RenderFillRect(renderer, &r1);
-      SDL_RenderFillRect(renderer, &r2);
-      SDL_RenderFillRect(renderer, &r3);
-      SDL_RenderFillRect(renderer, &r4);
-    } else if (c == 'R') {
-      SDL_Rect r1 = {current_x, y, 8 * scale, 2 * scale};
-      SDL_Rect r2 = {current_x, y + 4 * scale, 6 * scale, 2 * scale};
-      SDL_Rect r3 = {current_x, y, 2 * scale, 10 * scale};
-      SDL_Rect r4 = {current_x + 6 * scale, y + 2 * scale, 2 * scale,
-                      2 * scale};
-      SDL_Rect r5 = {current_x + 6 * scale, y + 6 * scale, 2 * scale,
-                      4 * scale};
-      SDL_Rect r6 = {current_x + 4 * scale, y + 6 * scale, 2 * scale,
-                      2 * scale};
-      SDL_RenderFillRect(renderer, &r1);
-      SDL_RenderFillRect(renderer, &r2);
-      SDL_RenderFillRect(renderer, &r3);
-      SDL_RenderFillRect(renderer, &r4);
-      SDL_RenderFillRect(renderer, &r5);
-      SDL_RenderFillRect(renderer, &r6);
-    } else if (c == 'E') {
-      SDL_Rect r1 = {current_x, y, 8 * scale, 2 * scale};
-      SDL_Rect r2 = {current_x, y + 4 * scale, 6 * scale, 2 * scale};
-      SDL_Rect r3 = {current_x, y + 8 * scale, 8 * scale, 2 * scale};
-      SDL_Rect r4 = {current_x, y, 2 * scale, 10 * scale};
-      SDL_RenderFillRect(renderer, &r1);
-      SDL_RenderFillRect(renderer, &r2);
-      SDL_RenderFillRect(renderer, &r3);
-      SDL_RenderFillRect(renderer, &r4);
-    } else if (c == ':') {
-      SDL_Rect r1 = {current_x + 2 * scale, y + 2 * scale, 2 * scale,
-                      2 * scale};
-      SDL_Rect r2 = {current_x + 2 * scale, y + 6 * scale, 2 * scale,
-                      2 * scale};
-      SDL_RenderFillRect(renderer, &r1);
-      SDL_RenderFillRect(renderer, &r2);
-    } else if (c == '0') {
-      SDL_Rect r1 = {current_x, y, 6 * scale, 2 * scale};
-      SDL_Rect r2 = {current_x, y + 8 * scale, 6 * scale, 2 * scale};
-      SDL_Rect r3 = {current_x, y, 2 * scale, 10 * scale};
-      SDL_Rect r4 = {current_x + 4 * scale, y, 2 * scale, 10 * scale};
-      SDL_RenderFillRect(renderer, &r1);
-      SDL_RenderFillRect(renderer, &r2);
-      SDL_RenderFillRect(renderer, &r3);
-      SDL_RenderFillRect(renderer, &r4);
-    } else if (c == '1') {
-      SDL_Rect r1 = {current_x + 2 * scale, y, 2 * scale, 10 * scale};
-      SDL_Rect r2 = {current_x, y + 2 * scale, 4 * scale, 2 * scale};
-      SDL_RenderFillRect(renderer, &r1);
-      SDL_RenderFillRect(renderer, &r2);
-    } else if (c == '2') {
-      SDL_Rect r1 = {current_x, y, 6 * scale, 2 * scale};
-      SDL_Rect r2 = {current_x, y + 4 * scale, 6 * scale, 2 * scale};
-      SDL_Rect r3 = {current_x, y + 8 * scale, 6 * scale, 2 * scale};
-      SDL_Rect r4 = {current_x + 4 * scale, y + 2 * scale, 2 * scale,
-                      2 * scale};
-      SDL_Rect r5 = {current_x, y + 6 * scale, 2 * scale, 2 * scale};
-      SDL_RenderFillRect(renderer, &r1);
-      SDL_RenderFillRect(renderer, &r2);
-      SDL_RenderFillRect(renderer, &r3);
-      SDL_RenderFillRect(renderer, &r4);
-      SDL_RenderFillRect(renderer, &r5);
-    } else if (c == 'G') {
-      SDL_Rect r1 = {current_x, y, 8 * scale, 2 * scale};
-      SDL_Rect r2 = {current_x, y + 8 * scale, 8 * scale, 2 * scale};
-      SDL_Rect r3 = {current_x, y + 4 * scale, 6 * scale, 2 * scale};
-      SDL_Rect r4 = {current_x, y, 2 * scale, 10 * scale};
-      SDL_Rect r5 = {current_x + 6 * scale, y + 6 * scale, 2 * scale,
-                      4 * scale};
-      SDL_RenderFillRect(renderer, &r1);
-      SDL_RenderFillRect(renderer, &r2);
-      SDL_RenderFillRect(renderer, &r3);
-      SDL_RenderFillRect(renderer, &r4);
-      SDL_RenderFillRect(renderer, &r5);
-    } else if (c == 'A') {
-      SDL_Rect r1 = {current_x + 2 * scale, y, 6 * scale, 2 * scale};
-      SDL_Rect r2 = {current_x, y + 2 * scale, 2 * scale, 8 * scale};
-      SDL_Rect r3 = {current_x + 8 * scale, y + 2 * scale, 2 * scale,
-                      8 * scale};
-      SDL_Rect r4 = {current_x + 2 * scale, y + 4 * scale, 6 * scale,
-                      2 * scale};
-      SDL_RenderFillRect(renderer, &r1);
-      SDL_RenderFillRect(renderer, &r2);
-      SDL_RenderFillRect(renderer, &r3);
-      SDL_RenderFillRect(renderer, &r4);
-    } else if (c == 'M') {
-      SDL_Rect r1 = {current_x, y, 2 * scale, 10 * scale};
-      SDL_Rect r2 = {current_x + 8 * scale, y, 2 * scale, 10 * scale};
-      SDL_Rect r3 = {current_x + 2 * scale, y, 2 * scale, 4 * scale};
-      SDL_Rect r4 = {current_x + 6 * scale, y, 2 * scale, 4 * scale};
-      SDL_Rect r5 = {current_x + 4 * scale, y + 2 * scale, 2 * scale,
-                      2 * scale};
-      SDL_RenderFillRect(renderer, &r1);
-      SDL_RenderFillRect(renderer, &r2);
-      SDL_RenderFillRect(renderer, &r3);
-      SDL_RenderFillRect(renderer, &r4);
-      SDL_RenderFillRect(renderer, &r5);
-    } else if (c == 'V') {
-      SDL_Rect r1 = {current_x, y, 2 * scale, 6 * scale};
-      SDL_Rect r2 = {current_x + 2 * scale, y + 6 * scale, 2 * scale,
-                      4 * scale};
-      SDL_Rect r3 = {current_x + 6 * scale, y + 6 * scale, 2 * scale,
-                      4 * scale};
-      SDL_Rect r4 = {current_x + 8 * scale, y, 2 * scale, 6 * scale};
-      SDL_RenderFillRect(renderer, &r1);
-      SDL_RenderFillRect(renderer, &r2);
-      SDL_RenderFillRect(renderer, &r3);
-      SDL_RenderFillRect(renderer, &r4);
-    } else if (c == 'T') {
-      SDL_Rect r1 = {current_x, y, 10 * scale, 2 * scale};
-      SDL_Rect r2 = {current_x + 4 * scale, y, 2 * scale, 10 * scale};
-      SDL_RenderFillRect(renderer, &r1);
-      SDL_RenderFillRect(renderer, &r2);
-    } else if (c == 'Q') {
-      SDL_Rect r1 = {current_x, y, 10 * scale, 2 * scale};
-      SDL_Rect r2 = {current_x, y + 8 * scale, 8 * scale, 2 * scale};
-      SDL_Rect r3 = {current_x, y, 2 * scale, 10 * scale};
-      SDL_Rect r4 = {current_x + 8 * scale, y, 2 * scale, 8 * scale};
-      SDL_Rect r5 = {current_x + 6 * scale, y + 6 * scale, 2 * scale,
-                      2 * scale};
-      SDL_Rect r6 = {current_x + 8 * scale, y + 8 * scale, 2 * scale,
-                      2 * scale};
-      SDL_RenderFillRect(renderer, &r1);
-      SDL_RenderFillRect(renderer, &r2);
-      SDL_RenderFillRect(renderer, &r3);
-      SDL_RenderFillRect(renderer, &r4);
-      SDL_RenderFillRect(renderer, &r5);
-      SDL_RenderFillRect(renderer, &r6);
-    } else if (c == 'U') {
-      SDL_Rect r1 = {current_x, y, 2 * scale, 8 * scale};
-      SDL_Rect r2 = {current_x + 8 * scale, y, 2 * scale, 8 * scale};
-      SDL_Rect r3 = {current_x, y + 8 * scale, 10 * scale, 2 * scale};
-      SDL_RenderFillRect(renderer, &r1);
-      SDL_RenderFillRect(renderer, &r2);
-      SDL_RenderFillRect(renderer, &r3);
-    } else if (c == 'I') {
-      SDL_Rect r1 = {current_x + 4 * scale, y, 2 * scale, 10 * scale};
-      SDL_RenderFillRect(renderer, &r1);
-    } else if (c == '3') {
-      SDL_Rect r1 = {current_x, y, 8 * scale, 2 * scale};
-      SDL_Rect r2 = {current_x, y + 4 * scale, 6 * scale, 2 * scale};
-      SDL_Rect r3 = {current_x, y + 8 * scale, 8 * scale, 2 * scale};
-      SDL_Rect r4 = {current_x + 6 * scale, y + 2 * scale, 2 * scale,
-                      2 * scale};
-      SDL_Rect r5 = {current_x + 6 * scale, y + 6 * scale, 2 * scale,
-                      2 * scale};
-      SDL_RenderFillRect(renderer, &r1);
-      SDL_RenderFillRect(renderer, &r2);
-      SDL_RenderFillRect(renderer, &r3);
-      SDL_RenderFillRect(renderer, &r4);
-      SDL_RenderFillRect(renderer, &r5);
-    } else if (c == '4') {
-      SDL_Rect r1 = {current_x + 4 * scale, y, 2 * scale,
-                      10 * scale}; // right vertical
-      SDL_Rect r2 = {current_x, y + 6 * scale, 6 * scale, 2 * scale}; // bottom
-      SDL_Rect r3 = {current_x + 2 * scale, y, 2 * scale,
-                      6 * scale}; // left top
-      SDL_RenderFillRect(renderer, &r1);
-      SDL_RenderFillRect(renderer, &r2);
-      SDL_RenderFillRect(renderer, &r3);
-    } else if (c == '5') {
-      SDL_Rect r1 = {current_x, y, 8 * scale, 2 * scale};
-      SDL_Rect r2 = {current_x, y + 4 * scale, 8 * scale, 2 * scale};
-      SDL_Rect r3 = {current_x, y + 8 * scale, 8 * scale, 2 * scale};
-      SDL_Rect r4 = {current_x, y, 2 * scale, 6 * scale};
-      SDL_Rect r5 = {current_x + 6 * scale, y + 4 * scale, 2 * scale,
-                      6 * scale};
-      SDL_RenderFillRect(renderer, &r1);
-      SDL_RenderFillRect(renderer, &r2);
-      SDL_RenderFillRect(renderer, &r3);
-      SDL_RenderFillRect(renderer, &r4);
-      SDL_RenderFillRect(renderer, &r5);
-    } else if (c == '6') {
-      SDL_Rect r1 = {current_x, y, 8 * scale, 2 * scale};
-      SDL_Rect r2 = {current_x, y + 4 * scale, 8 * scale, 2 * scale};
-      SDL_Rect r3 = {current_x, y + 8 * scale, 8 * scale, 2 * scale};
-      SDL_Rect r4 = {current_x, y, 2 * scale, 6 * scale};
-      SDL_Rect r5 = {current_x + 6 * scale, y + 4 * scale, 2 * scale,
-                      6 * scale};
-      SDL_RenderFillRect(renderer, &r1);
-      SDL_RenderFillRect(renderer, &r2);
-      SDL_RenderFillRect(renderer, &r3);
-      SDL_RenderFillRect(renderer, &r4);
-      SDL_RenderFillRect(renderer, &r5);
-    } else if (c == '7') {
-      SDL_Rect r1 = {current_x, y, 8 * scale, 2 * scale};
-      SDL_Rect r2 = {current_x + 6 * scale, y, 2 * scale, 10 * scale};
-      SDL_RenderFillRect(renderer, &r1);
-      SDL_RenderFillRect(renderer, &r2);
-    } else if (c == '8') {
-      SDL_Rect r1 = {current_x, y, 8 * scale, 2 * scale};
-      SDL_Rect r2 = {current_x, y + 4 * scale, 6 * scale, 2 * scale};
-      SDL_Rect r3 = {current_x, y + 8 * scale, 8 * scale, 2 * scale};
-      SDL_Rect r4 = {current_x, y, 2 * scale, 10 * scale};
-      SDL_Rect r5 = {current_x + 6 * scale, y, 2 * scale, 10 * scale};
-      SDL_RenderFillRect(renderer, &r1);
-      SDL_RenderFillRect(renderer, &r2);
-      SDL_RenderFillRect(renderer, &r3);
-      SDL_RenderFillRect(renderer, &r4);
-      SDL_RenderFillRect(renderer, &r5);
-    } else if (c == '9') {
-      SDL_Rect r1 = {current_x, y, 8 * scale, 2 * scale};
-      SDL_Rect r2 = {current_x, y + 4 * scale, 8 * scale, 2 * scale};
-      SDL_Rect r3 = {current_x, y + 8 * scale, 8 * scale, 2 * scale};
-      SDL_Rect r4 = {current_x, y, 2 * scale, 6 * scale};
-      SDL_Rect r5 = {current_x + 6 * scale, y, 2 * scale, 10 * scale};
-      SDL_RenderFillRect(renderer, &r1);
-      SDL_RenderFillRect(renderer, &r2);
-      SDL_RenderFillRect(renderer, &r3);
-      SDL_RenderFillRect(renderer, &r4);
-      SDL_RenderFillRect(renderer, &r5);
-    } else if (c == 'N') {
-      SDL_Rect r1 = {current_x, y, 2 * scale, 10 * scale};
-      SDL_Rect r2 = {current_x + 8 * scale, y, 2 * scale, 10 * scale};
-      SDL_Rect r3 = {current_x + 2 * scale, y, 2 * scale, 2 * scale};
-      SDL_Rect r4 = {current_x + 4 * scale, y + 2 * scale, 2 * scale,
-                      2 * scale};
-      SDL_Rect r5 = {current_x + 6 * scale, y + 4 * scale, 2 * scale,
-                      6 * scale};
-      SDL_RenderFillRect(renderer, &r1);
-      SDL_RenderFillRect(renderer, &r2);
-      SDL_RenderFillRect(renderer, &r3);
-      SDL_RenderFillRect(renderer, &r4);
-      SDL_RenderFillRect(renderer, &r5);
-    } else if (c == 'Y') {
-      SDL_Rect r1 = {current_x, y, 2 * scale, 4 * scale};
-      SDL_Rect r2 = {current_x + 8 * scale, y, 2 * scale, 4 * scale};
-      SDL_Rect r3 = {current_x + 4 * scale, y + 4 * scale, 2 * scale,
-                      6 * scale};
-      SDL_RenderFillRect(renderer, &r1);
-      SDL_RenderFillRect(renderer, &r2);
-      SDL_RenderFillRect(renderer, &r3);
-    } else if (c == 'H') {
-      SDL_Rect r1 = {current_x, y, 2 * scale, 10 * scale};
-      SDL_Rect r2 = {current_x + 8 * scale, y, 2 * scale, 10 * scale};
-      SDL_Rect r3 = {current_x + 2 * scale, y + 4 * scale, 6 * scale,
-                      2 * scale};
-      SDL_RenderFillRect(renderer, &r1);
-      SDL_RenderFillRect(renderer, &r2);
-      SDL_RenderFillRect(renderer, &r3);
-    } else if (c == 'P') {
-      SDL_Rect r1 = {current_x, y, 8 * scale, 2 * scale};
-      SDL_Rect r2 = {current_x, y + 4 * scale, 6 * scale, 2 * scale};
-      SDL_Rect r3 = {current_x, y, 2 * scale, 10 * scale};
-      SDL_Rect r4 = {current_x + 6 * scale, y + 2 * scale, 2 * scale,
-                      2 * scale};
-      SDL_RenderFillRect(renderer, &r1);
-      SDL_RenderFillRect(renderer, &r2);
-      SDL_RenderFillRect(renderer, &r3);
-      SDL_RenderFillRect(renderer, &r4);
-    } else if (c == 'D') {
-      SDL_Rect r1 = {current_x, y, 6 * scale, 2 * scale};
-      SDL_Rect r2 = {current_x, y + 8 * scale, 6 * scale, 2 * scale};
-      SDL_Rect r3 = {current_x, y, 2 * scale, 10 * scale};
-      SDL_Rect r4 = {current_x + 4 * scale, y + 2 * scale, 2 * scale,
-                      6 * scale};
-      SDL_RenderFillRect(renderer, &r1);
-      SDL_RenderFillRect(renderer, &r2);
-      SDL_RenderFillRect(renderer, &r3);
-      SDL_RenderFillRect(renderer, &r4);
-    } else if (c == 'K') {
-      SDL_Rect r1 = {current_x, y, 2 * scale, 10 * scale};
-      SDL_Rect r2 = {current_x + 6 * scale, y, 2 * scale, 4 * scale};
-      SDL_Rect r3 = {current_x + 4 * scale, y + 4 * scale, 2 * scale,
-                      2 * scale};
-      SDL_Rect r4 = {current_x + 6 * scale, y + 6 * scale, 2 * scale,
-                      4 * scale};
-      SDL_RenderFillRect(renderer, &r1);
-      SDL_RenderFillRect(renderer, &r2);
-      SDL_RenderFillRect(renderer, &r3);
-      SDL_RenderFillRect(renderer, &r4);
-    } else if (c == 'B') {
-      SDL_Rect r1 = {current_x, y, 6 * scale, 2 * scale};
-      SDL_Rect r2 = {current_x, y + 4 * scale, 6 * scale, 2 * scale};
-      SDL_Rect r3 = {current_x, y + 8 * scale, 6 * scale, 2 * scale};
-      SDL_Rect r4 = {current_x, y, 2 * scale, 10 * scale};
-      SDL_Rect r5 = {current_x + 6 * scale, y + 2 * scale, 2 * scale,
-                      2 * scale};
-      SDL_Rect r6 = {current_x + 6 * scale, y + 6 * scale, 2 * scale,
-                      2 * scale};
-      SDL_RenderFillRect(renderer, &r1);
-      SDL_RenderFillRect(renderer, &r2);
-      SDL_RenderFillRect(renderer, &r3);
-      SDL_RenderFillRect(renderer, &r4);
-      SDL_RenderFillRect(renderer, &r5);
-      SDL_RenderFillRect(renderer, &r6);
-    } else if (c == 'F') {
-      SDL_Rect r1 = {current_x, y, 8 * scale, 2 * scale};
-      SDL_Rect r2 = {current_x, y + 4 * scale, 6 * scale, 2 * scale};
-      SDL_Rect r3 = {current_x, y, 2 * scale, 10 * scale};
-      SDL_RenderFillRect(renderer, &r1);
-      SDL_RenderFillRect(renderer, &r2);
-      SDL_RenderFillRect(renderer, &r3);
-    } else if (c == 'L') {
-      SDL_Rect r1 = {current_x, y, 2 * scale, 10 * scale};
-      SDL_Rect r2 = {current_x, y + 8 * scale, 8 * scale, 2 * scale};
-      SDL_RenderFillRect(renderer, &r1);
-      SDL_RenderFillRect(renderer, &r2);
-    } else if (c == 'W') {
-      SDL_Rect r1 = {current_x, y, 2 * scale, 10 * scale};
-      SDL_Rect r2 = {current_x + 8 * scale, y, 2 * scale, 10 * scale};
-      SDL_Rect r3 = {current_x + 2 * scale, y + 6 * scale, 2 * scale,
-                      4 * scale};
-      SDL_Rect r4 = {current_x + 6 * scale, y + 6 * scale, 2 * scale,
-                      4 * scale};
-      SDL_Rect r5 = {current_x + 4 * scale, y + 8 * scale, 2 * scale,
-                      2 * scale};
-      SDL_RenderFillRect(renderer, &r1);
-      SDL_RenderFillRect(renderer, &r2);
-      SDL_RenderFillRect(renderer, &r3);
-      SDL_RenderFillRect(renderer, &r4);
-      SDL_RenderFillRect(renderer, &r5);
-    }
-
-    current_x += 12 * scale;
-  }
-}
-
-void draw_die_menu(DieMenu *menu, SDL_Renderer *renderer) {
+void draw_die_menu(DieMenu *menu, SDL_Renderer *renderer, UiPanel *panel) {
   if (!menu->is_active)
     return;
 
@@ -496,6 +126,16 @@ void draw_die_menu(DieMenu *menu, SDL_Renderer *renderer) {
   int window_width, window_height;
   SDL_GetRendererOutputSize(renderer, &window_width, &window_height);
 
+  // Layout and text only change with the selection or the window size
+  unsigned long key = ui_hash_int(UI_HASH_SEED, 4);
+  key = ui_hash_int(key, menu->selected_option);
+  key = ui_hash_int(key, window_width);
+  key = ui_hash_int(key, window_height);
+  if (!ui_panel_begin(panel, renderer, window_width, window_height, key)) {
+    ui_panel_draw(panel, renderer);
+    return;
+  }
+
   // Draw semi-transparent background
   SDL_SetRenderDrawColor(renderer, menu->background_color.r,
                          menu->background_color.g, menu->background_color.b,
@@ -541,27 +181,6 @@ void draw_die_menu(DieMenu *menu, SDL_Renderer *renderer) {
     float quit_width = get_text_width(quit_text, 3.0f);
     draw_text(renderer, quit_text, center_x - quit_width / 2, center_y + 135, quit_color, 3.0f);
 
-
-}
-
-void reset_game_state(float *player_x, float *player_y, float *player_health,
-                      int *player_is_alive, EnemyManager *enemies, int *score, int difficulty_level) {
-  // Reset player state
-  *player_x = 200.0f;
-  *player_y = 100.0f;
-  *player_health = 200.0f;
-  *player_is_alive = 1;
-  *score = 0; // Reset score
-
-  // Clear all enemies
-  cleanup_enemy_manager(enemies);
-  initialize_enemy_manager(enemies, 1000);
-
-  // Add starting enemies again
-  add_enemy_to_manager(enemies, 400.0f, 300.0f, 1, difficulty_level);
-  add_enemy_to_manager(enemies, 100.0f, 100.0f, 1, difficulty_level);
-  add_enemy_to_manager(enemies, 600.0f, 400.0f, 1, difficulty_level);
-  add_enemy_to_manager(enemies, 200.0f, 500.0f, 1, difficulty_level);
-
-  printf("Game restarted!\n");
+    ui_panel_end(panel, renderer);
+    ui_panel_draw(panel, renderer);
 }
@@ -1,7 +1,7 @@
 #ifndef DIE_MENU_H
 #define DIE_MENU_H
 
-#include "enemy.h"
+#include "uiCache.h"
 #include <SDL2/SDL.h>
 
 typedef enum {
@@ -26,8 +26,6 @@ typedef struct {
 void initialize_die_menu(DieMenu *menu);
 void update_die_menu(DieMenu *menu, SDL_Event *event, int *game_running,
                      int *restart_game, int *go_to_main_menu);
-void draw_die_menu(DieMenu *menu, SDL_Renderer *renderer);
-void reset_game_state(float *player_x, float *player_y, float *player_health,
-                      int *player_is_alive, EnemyManager *enemies, int *score, int difficulty_level);
+void draw_die_menu(DieMenu *menu, SDL_Renderer *renderer, UiPanel *panel);
 
 #endif
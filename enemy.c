@@ -1,13 +1,22 @@
 #include "enemy.h"
-#include <SDL2/SDL_mixer.h>
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 
-void initialize_enemy_manager(EnemyManager *manager, int max_capacity) {
-  manager->enemies_array = malloc(sizeof(Enemy) * max_capacity);
+// Storage comes from the arena and is kept for the arena's lifetime, so a
+// restart only has to reset the count
+void initialize_enemy_manager(EnemyManager *manager, Arena *arena,
+                              int max_capacity) {
+  manager->enemies_array = arena_alloc(arena, sizeof(Enemy) * max_capacity);
+  manager->current_enemy_count = 0;
+  manager->max_enemy_capacity = manager->enemies_array ? max_capacity : 0;
+  manager->lod_distance = 0.0f;
+  manager->health_bars = 1;
+}
+
+// Drop all enemies but keep the storage
+void reset_enemy_manager(EnemyManager *manager) {
   manager->current_enemy_count = 0;
-  manager->max_enemy_capacity = max_capacity;
 }
 
 void add_enemy_to_manager(EnemyManager *manager, float start_x, float start_y,
@@ -20,8 +29,6 @@ void add_enemy_to_manager(EnemyManager *manager, float start_x, float start_y,
   new_enemy->position_y = start_y;
   new_enemy->is_alive = 1;
   new_enemy->enemy_type = enemy_type;
-  new_enemy->is_exploding = 0;
-  new_enemy->explosion_timer = 0.0f;
   new_enemy->damage_to_player = 10.0f;
   new_enemy->has_spawned_death_projectiles = 0;
   new_enemy->has_spawned_minions = 0;
@@ -60,11 +67,10 @@ int check_collision(float x1, float y1, float w1, float h1, float x2, float y2,
 float handle_player_enemy_collision_damage(EnemyManager *manager,
                                            float player_x, float player_y,
                                            float player_w, float player_h,
-                                           int *score, Mix_Chunk *explode_sound) {
+                                           int *score, VoiceManager *audio) {
   float total_damage_taken = 0.0f;
   for (int i = 0; i < manager->current_enemy_count; i++) {
-    if (!manager->enemies_array[i].is_alive ||
-        manager->enemies_array[i].is_exploding)
+    if (!manager->enemies_array[i].is_alive)
       continue;
 
     Enemy *enemy = &manager->enemies_array[i];
@@ -75,9 +81,8 @@ float handle_player_enemy_collision_damage(EnemyManager *manager,
       // Player takes damage
       total_damage_taken += 15.0f;
        // Enemy dies
-       enemy->is_exploding = 1;
-       enemy->explosion_timer = 0.3f;
-       if (explode_sound) Mix_PlayChannel(-1, explode_sound, 0);
+       enemy->is_alive = 0;
+       audio_trigger(audio, SOUND_EXPLODE);
        *score += 5;
       printf("Player collided with enemy! Took 15 damage.\n");
     }
@@ -85,22 +90,6 @@ float handle_player_enemy_collision_damage(EnemyManager *manager,
   return total_damage_taken;
 }
 
-// Update explosion animations
-void update_explosions(EnemyManager *manager, float time_since_last_frame) {
-  for (int i = 0; i < manager->current_enemy_count; i++) {
-    if (manager->enemies_array[i].is_exploding) {
-      manager->enemies_array[i].explosion_timer -= time_since_last_frame;
-
-      // When explosion finishes, mark enemy as dead
-      if (manager->enemies_array[i].explosion_timer <= 0) {
-        manager->enemies_array[i].is_alive = 0;
-        manager->enemies_array[i].is_exploding = 0;
-        printf("Enemy removed from game.\n");
-      }
-    }
-  }
-}
-
 // Remove dead enemies from the array to free up space
 void cleanup_dead_enemies(EnemyManager *manager) {
   int write_index = 0;
@@ -124,8 +113,6 @@ int would_collide(Enemy *enemy, float new_x, float new_y, EnemyManager *manager,
       continue;
     if (!manager->enemies_array[i].is_alive)
       continue;
-    if (manager->enemies_array[i].is_exploding)
-      continue; // Don't collide with exploding enemies
 
     Enemy *other = &manager->enemies_array[i];
     if (check_collision(new_x, new_y, enemy->width, enemy->height,
@@ -150,8 +137,8 @@ void update_single_enemy(Enemy *enemy, float target_x, float target_y,
                          float time_since_last_frame, EnemyManager *manager,
                          int enemy_index, float player_x, float player_y,
                          float player_w, float player_h) {
-  // Don't update if dead or exploding
-  if (!enemy->is_alive || enemy->is_exploding)
+  // Don't update if dead
+  if (!enemy->is_alive)
     return;
 
   // Calculate direction to target
@@ -174,6 +161,14 @@ void update_single_enemy(Enemy *enemy, float target_x, float target_y,
   float desired_move_y =
       direction_y * enemy->movement_speed * time_since_last_frame;
 
+  // Far from the player nobody sees them jostle; skip the avoidance checks
+  if (manager->lod_distance > 0.0f &&
+      distance_to_target > manager->lod_distance) {
+    enemy->position_x += desired_move_x;
+    enemy->position_y += desired_move_y;
+    return;
+  }
+
   // Try moving in X direction first (if no collision)
   float new_x = enemy->position_x + desired_move_x;
   float new_y = enemy->position_y;
@@ -191,19 +186,29 @@ void update_single_enemy(Enemy *enemy, float target_x, float target_y,
   }
 }
 
-// Fallback: if enemies do overlap, push them apart
-void resolve_any_collisions(EnemyManager *manager) {
+// Square distance from an enemy to the player, for the LOD cut-off
+static float distance_sq_to(const Enemy *enemy, float x, float y) {
+  float dx = x - enemy->position_x;
+  float dy = y - enemy->position_y;
+  return dx * dx + dy * dy;
+}
+
+// Fallback: if enemies do overlap, push them apart. With a LOD distance set,
+// pairs where the first enemy is out of range are skipped.
+void resolve_any_collisions(EnemyManager *manager, float player_x,
+                            float player_y) {
+  float lod_sq = manager->lod_distance * manager->lod_distance;
   for (int i = 0; i < manager->current_enemy_count; i++) {
-    if (!manager->enemies_array[i].is_alive ||
-        manager->enemies_array[i].is_exploding)
+    if (!manager->enemies_array[i].is_alive)
       continue;
 
     Enemy *enemy1 = &manager->enemies_array[i];
+    if (lod_sq > 0.0f && distance_sq_to(enemy1, player_x, player_y) > lod_sq)
+      continue;
 
     // Check collision with other enemies
     for (int j = i + 1; j < manager->current_enemy_count; j++) {
-      if (!manager->enemies_array[j].is_alive ||
-          manager->enemies_array[j].is_exploding)
+      if (!manager->enemies_array[j].is_alive)
         continue;
 
       Enemy *enemy2 = &manager->enemies_array[j];
@@ -231,87 +236,44 @@ void resolve_any_collisions(EnemyManager *manager) {
   }
 }
 
-void draw_single_enemy(Enemy *enemy, SDL_Renderer *renderer) {
+void draw_single_enemy(Enemy *enemy, RenderCommandBuffer *commands,
+                       int health_bars) {
   if (!enemy->is_alive)
     return;
 
-  if (enemy->is_exploding) {
-    // Explosion effect - changing colors and growing size
-    float explosion_progress = 1.0f - (enemy->explosion_timer / 0.3f);
-    int red = 255;
-    int green = (int)(255 * explosion_progress);
-    int blue = 0;
-
-    // For purple enemies, make explosion purple
-    if (enemy->enemy_type == 2) {
-      red = 128;
-      blue = 128;
-    } else if (enemy->enemy_type == 3) { // Boss explosion
-      red = 255;
-      green = (int)(128 * explosion_progress);
-      blue = 0;
-    }
-
-    float base_size = (enemy->enemy_type == 3) ? 100.0f : 40.0f;
-    float explosion_size = base_size + (20.0f * explosion_progress);
-    float offset = (explosion_size - base_size) / 2.0f;
-
-    SDL_SetRenderDrawColor(renderer, red, green, blue, 255);
-    SDL_Rect explosion_rect = {enemy->position_x - offset,
-                                enemy->position_y - offset, explosion_size,
-                                explosion_size};
-    SDL_RenderFillRect(renderer, &explosion_rect);
-
-    // Draw some explosion particles (simple circles)
-    SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255);
-    for (int i = 0; i < 4; i++) {
-      float angle = (float)i * 3.14159f / 2.0f;
-      float particle_x =
-          enemy->position_x + cosf(angle) * explosion_size * 0.6f;
-      float particle_y =
-          enemy->position_y + sinf(angle) * explosion_size * 0.6f;
-
-      SDL_Rect particle = {particle_x - 2, particle_y - 2, 4, 4};
-      SDL_RenderFillRect(renderer, &particle);
-    }
+  // Normal enemy - color based on type and health
+  int red = 0, green = 255, blue = 255;
+  if (enemy->enemy_type == 2) {
+    red = 128;
+    green = 0;
+    blue = 128; // Purple
+  } else if (enemy->enemy_type == 3) {
+    red = 255;
+    green = 128;
+    blue = 0; // Yellowish-red for boss
+  } else if (enemy->enemy_type == 4) {
+    red = 255;
+    green = 165;
+    blue = 0; // Bright orange for minions
   } else {
-    // Normal enemy - color based on type and health
-    int red = 0, green = 255, blue = 255;
-    if (enemy->enemy_type == 2) {
-      red = 128;
-      green = 0;
-      blue = 128; // Purple
-    } else if (enemy->enemy_type == 3) {
-      red = 255;
-      green = 128;
-      blue = 0; // Yellowish-red for boss
-    } else if (enemy->enemy_type == 4) {
-      red = 255;
-      green = 165;
-      blue = 0; // Bright orange for minions
-    } else {
-      int damage_percent = (int)((enemy->max_health - enemy->health_points) / (float)enemy->max_health * 255);
-      green = 255 - damage_percent;
-    }
+    int damage_percent = (int)((enemy->max_health - enemy->health_points) / (float)enemy->max_health * 255);
+    green = 255 - damage_percent;
+  }
 
-    SDL_SetRenderDrawColor(renderer, red, green, blue, 255);
-    SDL_Rect enemy_rectangle = {enemy->position_x, enemy->position_y,
-                                 enemy->width, enemy->height};
-    SDL_RenderFillRect(renderer, &enemy_rectangle);
-
-    // Draw health bar for non-minions
-    if (enemy->enemy_type != 4) {
-      SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
-    SDL_Rect health_bg = {enemy->position_x, enemy->position_y - 5,
-                           enemy->width, 3};
-      SDL_RenderFillRect(renderer, &health_bg);
-
-      SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);
-      float health_ratio = enemy->health_points / (float)enemy->max_health;
-    SDL_Rect health_bar = {enemy->position_x, enemy->position_y - 5,
-                            enemy->width * health_ratio, 3};
-      SDL_RenderFillRect(renderer, &health_bar);
-    }
+  emit_quad(commands, RENDER_LAYER_ENEMIES, enemy->position_x,
+            enemy->position_y, enemy->width, enemy->height,
+            (SDL_Color){red, green, blue, 255});
+
+  // Draw health bar for non-minions
+  if (health_bars && enemy->enemy_type != 4) {
+    emit_quad(commands, RENDER_LAYER_HEALTH_BG, enemy->position_x,
+              enemy->position_y - 5, enemy->width, 3,
+              (SDL_Color){255, 0, 0, 255});
+
+    float health_ratio = enemy->health_points / (float)enemy->max_health;
+    emit_quad(commands, RENDER_LAYER_HEALTH_FG, enemy->position_x,
+              enemy->position_y - 5, enemy->width * health_ratio, 3,
+              (SDL_Color){0, 255, 0, 255});
   }
 }
 
@@ -326,22 +288,20 @@ void update_all_enemies(EnemyManager *manager, float target_x, float target_y,
   }
 
   // Then resolve any remaining collisions (as backup)
-  resolve_any_collisions(manager);
-
-  // Update explosion animations
-  update_explosions(manager, time_since_last_frame);
+  resolve_any_collisions(manager, target_x, target_y);
 }
 
-void draw_all_enemies(EnemyManager *manager, SDL_Renderer *renderer) {
+void draw_all_enemies(EnemyManager *manager, RenderCommandBuffer *commands) {
   for (int i = 0; i < manager->current_enemy_count; i++) {
-    draw_single_enemy(&manager->enemies_array[i], renderer);
+    draw_single_enemy(&manager->enemies_array[i], commands,
+                      manager->health_bars);
   }
 }
 
 
 
+// The array belongs to the arena it was allocated from; just detach it
 void cleanup_enemy_manager(EnemyManager *manager) {
-  free(manager->enemies_array);
   manager->enemies_array = NULL;
   manager->current_enemy_count = 0;
   manager->max_enemy_capacity = 0;
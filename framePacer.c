@@ -0,0 +1,120 @@
+#include "framePacer.h"
+#include <stdio.h>
+
+// SDL_Delay can oversleep by about a millisecond, so the last stretch
+// before a deadline is spun instead
+#define SPIN_MS 2.0
+#define ERROR_SMOOTHING 0.05f
+
+static float ticks_to_ms(const FramePacer *pacer, Uint64 ticks) {
+  return (float)((double)ticks * 1000.0 / pacer->frequency);
+}
+
+void frame_pacer_init(FramePacer *pacer, PaceMode mode, float rate_hz) {
+  pacer->mode = mode;
+  pacer->frequency = SDL_GetPerformanceFrequency();
+  if (mode == PACE_UNCAPPED || rate_hz <= 0.0f) {
+    rate_hz = 0.0f;
+    pacer->period = 0;
+  } else {
+    pacer->period = (Uint64)((double)pacer->frequency / rate_hz + 0.5);
+  }
+  pacer->rate_hz = rate_hz;
+  pacer->last_end = SDL_GetPerformanceCounter();
+  pacer->deadline = pacer->last_end + pacer->period;
+  pacer->frame_ms = rate_hz > 0.0f ? 1000.0f / rate_hz : 16.0f;
+  pacer->error_ms = 0.0f;
+  pacer->worst_error_ms = 0.0f;
+  pacer->total_error_ms = 0.0;
+  pacer->frames = 0;
+  pacer->missed = 0;
+  pacer->resync = 0;
+}
+
+// Sleep most of the way to the deadline, then spin the rest
+static void wait_until(FramePacer *pacer, Uint64 deadline) {
+  Uint64 now = SDL_GetPerformanceCounter();
+  if (now >= deadline)
+    return;
+  double remaining_ms = (double)(deadline - now) * 1000.0 / pacer->frequency;
+  if (remaining_ms > SPIN_MS) {
+    SDL_Delay((Uint32)(remaining_ms - SPIN_MS));
+  }
+  while (SDL_GetPerformanceCounter() < deadline) {
+  }
+}
+
+// Call once per frame right after SDL_RenderPresent
+void frame_pacer_end_frame(FramePacer *pacer) {
+  if (pacer->mode == PACE_TARGET_FPS && pacer->period > 0) {
+    wait_until(pacer, pacer->deadline);
+  }
+
+  Uint64 now = SDL_GetPerformanceCounter();
+  Uint64 interval = now - pacer->last_end;
+  pacer->last_end = now;
+  pacer->frame_ms = ticks_to_ms(pacer, interval);
+  if (pacer->resync) {
+    pacer->resync = 0;
+    pacer->deadline = now + pacer->period;
+    return;
+  }
+
+  if (pacer->mode == PACE_TARGET_FPS && pacer->period > 0) {
+    // Stay on the grid so the average rate is exact; start a new grid
+    // after a long stall instead of rushing frames to catch up
+    pacer->deadline += pacer->period;
+    if (now >= pacer->deadline) {
+      pacer->deadline = now + pacer->period;
+    }
+  }
+
+  if (pacer->period == 0)
+    return;
+  float error = pacer->frame_ms - ticks_to_ms(pacer, pacer->period);
+  if (error < 0.0f)
+    error = -error;
+  pacer->error_ms += (error - pacer->error_ms) * ERROR_SMOOTHING;
+  if (error > pacer->worst_error_ms)
+    pacer->worst_error_ms = error;
+  pacer->total_error_ms += error;
+  pacer->frames++;
+  if (interval * 2 > pacer->period * 3)
+    pacer->missed++;
+}
+
+// Forget the time spent idle (blocked waiting for events) so it neither
+// shows up as one huge frame nor counts as a pacing error
+void frame_pacer_reset(FramePacer *pacer) {
+  pacer->last_end = SDL_GetPerformanceCounter();
+  pacer->deadline = pacer->last_end + pacer->period;
+  pacer->frame_ms = pacer->rate_hz > 0.0f ? 1000.0f / pacer->rate_hz : 16.0f;
+  pacer->resync = 1;
+}
+
+// Seconds the last frame took, for the next simulation step
+float frame_pacer_frame_time(const FramePacer *pacer) {
+  return pacer->frame_ms / 1000.0f;
+}
+
+const char *frame_pacer_mode_name(PaceMode mode) {
+  switch (mode) {
+  case PACE_VSYNC:
+    return "VSYNC";
+  case PACE_TARGET_FPS:
+    return "FPS";
+  default:
+    return "UNCAPPED";
+  }
+}
+
+void frame_pacer_report(const FramePacer *pacer) {
+  if (pacer->frames == 0)
+    return;
+  printf("Frame pacing (%s %.0f Hz): %lu frames, mean error %.2f ms, "
+         "worst %.2f ms, %lu missed\n",
+         frame_pacer_mode_name(pacer->mode), pacer->rate_hz,
+         (unsigned long)pacer->frames,
+         pacer->total_error_ms / (double)pacer->frames,
+         pacer->worst_error_ms, (unsigned long)pacer->missed);
+}
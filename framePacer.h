@@ -0,0 +1,41 @@
+#ifndef FRAMEPACER_H
+#define FRAMEPACER_H
+
+#include <SDL2/SDL.h>
+
+typedef enum {
+  PACE_VSYNC,      // SDL_RenderPresent blocks on the display refresh
+  PACE_TARGET_FPS, // Sleep, then spin, up to a fixed frame deadline
+  PACE_UNCAPPED    // No waiting at all, for benchmarking
+} PaceMode;
+
+// Ends every frame at a steady rate and measures how far each frame lands
+// from where it should have. In target mode frames are scheduled on a fixed
+// grid of deadlines on the high-resolution counter: most of the wait is an
+// SDL_Delay, the last couple of milliseconds are spun so the deadline is hit
+// to well under a millisecond.
+typedef struct {
+  PaceMode mode;
+  Uint64 frequency;    // Counter ticks per second
+  Uint64 period;       // Counter ticks per frame, 0 when uncapped
+  Uint64 deadline;     // When the current frame should end (target mode)
+  Uint64 last_end;     // When the previous frame ended
+  float rate_hz;       // Frames per second aimed for, 0 when uncapped
+  float frame_ms;      // Last frame interval
+  float error_ms;      // Smoothed distance of the interval from the period
+  float worst_error_ms;
+  double total_error_ms;
+  Uint64 frames;
+  Uint64 missed; // Frames that took over one and a half periods
+  int resync;    // Next frame starts a new schedule and isn't measured
+} FramePacer;
+
+// Function declarations
+void frame_pacer_init(FramePacer *pacer, PaceMode mode, float rate_hz);
+void frame_pacer_end_frame(FramePacer *pacer);
+void frame_pacer_reset(FramePacer *pacer);
+float frame_pacer_frame_time(const FramePacer *pacer);
+const char *frame_pacer_mode_name(PaceMode mode);
+void frame_pacer_report(const FramePacer *pacer);
+
+#endif
@@ -0,0 +1,432 @@
+#include "game.h"
+#include "text.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int initialize_game(GameState *game, Arena *arena, PlayerUpgrades *upgrades,
+                    VoiceManager *audio) {
+  memset(game, 0, sizeof(*game));
+  game->upgrades = upgrades;
+  game->audio = audio;
+  game->window_w = 800;
+  game->window_h = 600;
+  game->explosion_particles = 12;
+
+  // Enemy system setup
+  initialize_enemy_manager(&game->enemies, arena, 1000); // Room for 1000 enemies
+
+  // Projectile systems
+  game->projectiles =
+      arena_alloc_zeroed(arena, sizeof(Projectile) * MAX_PLAYER_PROJECTILES);
+  game->enemy_projectiles = arena_alloc_zeroed(
+      arena, sizeof(EnemyProjectile) * MAX_ENEMY_PROJECTILES);
+  if (!game->enemies.enemies_array || !game->projectiles ||
+      !game->enemy_projectiles ||
+      !initialize_particles(&game->particles, arena)) {
+    return 0;
+  }
+
+  new_game(game);
+  return 1;
+}
+
+void new_game(GameState *game) {
+  // Reset player state
+  game->player_x = 200.0f;
+  game->player_y = 100.0f;
+  game->player_width = 50.0f;
+  game->player_height = 50.0f;
+  game->player_speed = 300.0f; // 5 pixels a frame at 60 fps
+  game->player_health = 200.0f;
+  game->player_is_alive = 1;
+  game->score = 0;
+
+  // Clear all enemies (storage is reused) and create the starting ones
+  reset_enemy_manager(&game->enemies);
+  add_enemy_to_manager(&game->enemies, 400.0f, 300.0f, 1, 0); // Middle
+  add_enemy_to_manager(&game->enemies, 100.0f, 100.0f, 1, 0); // Top-left
+  add_enemy_to_manager(&game->enemies, 600.0f, 400.0f, 1, 0); // Bottom-right
+  add_enemy_to_manager(&game->enemies, 200.0f, 500.0f, 1, 0); // Bottom-left
+
+  reset_particles(&game->particles);
+
+  // Reset projectiles and difficulty
+  for (int i = 0; i < MAX_PLAYER_PROJECTILES; i++)
+    game->projectiles[i].alive = 0;
+  game->projectile_count = 0;
+  for (int i = 0; i < MAX_ENEMY_PROJECTILES; i++)
+    game->enemy_projectiles[i].alive = 0;
+  game->enemy_proj_count = 0;
+  game->total_play_time = 0.0f;
+  game->enemy_spawn_timer = 0.0f;
+  game->enemies_spawned_count = 0;
+  game->hud_score = -1;
+  game->last_move_x = 0.0f;
+  game->last_move_y = 0.0f;
+  game->input_count = 0;
+}
+
+void clear_game_input(GameInput *input) {
+  input->shot_count = 0;
+  input->spawn_requests = 0;
+  input->move_count = 0;
+}
+
+// Fire one volley from (origin_x, origin_y) towards (aim_x, aim_y), with the
+// upgrade spread shots. The volley was fired back_time seconds into the
+// step, so it is pulled back by that much: the full-step move that follows
+// leaves it where it would be had it been fired at that moment.
+static void fire_player_shot(GameState *game, float origin_x, float origin_y,
+                             float aim_x, float aim_y, float back_time) {
+  Projectile *projectiles = game->projectiles;
+  if (game->projectile_count >= MAX_PLAYER_PROJECTILES)
+    return;
+
+  int first = game->projectile_count;
+  Projectile *p = &projectiles[game->projectile_count++];
+  p->x = origin_x;
+  p->y = origin_y;
+  float dx = aim_x - p->x;
+  float dy = aim_y - p->y;
+  float dist = sqrtf(dx * dx + dy * dy);
+  if (dist > 0) {
+    p->vx = (dx / dist) * 500.0f;
+    p->vy = (dy / dist) * 500.0f;
+  } else {
+    p->vx = 500.0f;
+    p->vy = 0.0f;
+  }
+  p->alive = 1;
+  // Double shots upgrade
+  if (game->upgrades->double_shots &&
+      game->projectile_count < MAX_PLAYER_PROJECTILES) {
+    Projectile *p2 = &projectiles[game->projectile_count++];
+    p2->x = p->x;
+    p2->y = p->y;
+    float angle = atan2f(dy, dx);
+    float offset_angle = 0.1f; // Tighter spread ~6 degrees
+    float new_angle = angle + offset_angle;
+    p2->vx = cosf(new_angle) * 500.0f;
+    p2->vy = sinf(new_angle) * 500.0f;
+    p2->alive = 1;
+  }
+  // Triple shots upgrade
+  if (game->upgrades->triple_shots &&
+      game->projectile_count < MAX_PLAYER_PROJECTILES) {
+    // Shoot two additional projectiles with wider spread
+    for (int i = 0; i < 2 && game->projectile_count < MAX_PLAYER_PROJECTILES;
+         i++) {
+      Projectile *p_extra = &projectiles[game->projectile_count++];
+      p_extra->x = p->x;
+      p_extra->y = p->y;
+      float angle = atan2f(dy, dx);
+      float offset_angle = (i == 0) ? -0.3f : 0.3f; // Left and right
+      float new_angle = angle + offset_angle;
+      p_extra->vx = cosf(new_angle) * 500.0f;
+      p_extra->vy = sinf(new_angle) * 500.0f;
+      p_extra->alive = 1;
+    }
+  }
+
+  for (int i = first; i < game->projectile_count; i++) {
+    projectiles[i].x -= projectiles[i].vx * back_time;
+    projectiles[i].y -= projectiles[i].vy * back_time;
+  }
+}
+
+// How far into the step (0..1) an event happened
+static float step_fraction(const GameInput *input, Uint32 timestamp) {
+  Uint32 span = input->step_end - input->step_start;
+  if (span == 0)
+    return 1.0f;
+  float fraction = (float)(Sint32)(timestamp - input->step_start) / span;
+  if (fraction < 0.0f)
+    return 0.0f;
+  if (fraction > 1.0f)
+    return 1.0f;
+  return fraction;
+}
+
+static void spawn_timed_enemy(GameState *game, int difficulty_level) {
+  EnemyManager *enemies = &game->enemies;
+
+  // Update difficulty based on play time
+  int current_max_enemies = 15 + difficulty_level * 5;
+  float current_spawn_time = 3.0f - difficulty_level * 0.2f;
+  if (current_spawn_time < 0.3f)
+    current_spawn_time = 0.3f;
+
+  // Dead enemies leave the store in the step they die, so everything in it
+  // is alive
+  int alive_enemies_count = enemies->current_enemy_count;
+
+  // Spawn new enemy if timer reached and we're under the limit
+  if (game->enemy_spawn_timer < current_spawn_time ||
+      alive_enemies_count >= current_max_enemies ||
+      enemies->current_enemy_count >= enemies->max_enemy_capacity) {
+    return;
+  }
+
+  // Find a spawn position away from player
+  float spawn_x = 0.0f, spawn_y = 0.0f;
+  int attempts = 0;
+  int found_good_position = 0;
+
+  while (attempts < 10 && !found_good_position) {
+    // Try to spawn at edge of screen
+    int side = rand() % 4; // 0=top, 1=right, 2=bottom, 3=left
+    switch (side) {
+    case 0: // Top
+      spawn_x = (rand() % 700) + 50.0f;
+      spawn_y = 20.0f;
+      break;
+    case 1: // Right
+      spawn_x = 750.0f;
+      spawn_y = (rand() % 500) + 50.0f;
+      break;
+    case 2: // Bottom
+      spawn_x = (rand() % 700) + 50.0f;
+      spawn_y = 550.0f;
+      break;
+    case 3: // Left
+      spawn_x = 20.0f;
+      spawn_y = (rand() % 500) + 50.0f;
+      break;
+    }
+
+    // Check if spawn position is not too close to player
+    float dx = spawn_x - game->player_x;
+    float dy = spawn_y - game->player_y;
+    float distance_to_player = sqrtf(dx * dx + dy * dy);
+
+    if (distance_to_player > 150.0f) { // At least 150 pixels from player
+      found_good_position = 1;
+    }
+
+    attempts++;
+  }
+
+  // If no good position found, use random position
+  if (!found_good_position) {
+    spawn_x = (rand() % 700) + 50.0f;
+    spawn_y = (rand() % 500) + 50.0f;
+  }
+
+  int enemy_type = (rand() % 3 == 0) ? 2 : 1; // 33% chance for purple enemy
+  // Boss spawn chance after 5 minutes
+  if (game->total_play_time > 300.0f && rand() % 20 == 0) {
+    enemy_type = 3; // Boss
+  }
+  // Adjust spawn position based on window size
+  if (spawn_x > game->window_w - 50)
+    spawn_x = game->window_w - 50;
+  if (spawn_y > game->window_h - 50)
+    spawn_y = game->window_h - 50;
+  add_enemy_to_manager(enemies, spawn_x, spawn_y, enemy_type,
+                       difficulty_level);
+  game->enemies_spawned_count++;
+  game->enemy_spawn_timer = 0.0f; // Reset timer
+
+  printf("Auto-spawn: Enemy #%d spawned at (%.0f, %.0f). Alive enemies: "
+         "%d/%d (Difficulty: %d)\n",
+         game->enemies_spawned_count, spawn_x, spawn_y,
+         alive_enemies_count + 1, current_max_enemies, difficulty_level);
+}
+
+void update_game(GameState *game, const GameInput *input) {
+  float frame_time = input->frame_time;
+  EnemyManager *enemies = &game->enemies;
+
+  game->window_w = input->window_w;
+  game->window_h = input->window_h;
+  enemies->lod_distance = input->quality.sim_lod_distance;
+  game->explosion_particles = input->quality.explosion_particles;
+  enemies->health_bars = input->quality.health_bars;
+
+  // Update total play time
+  game->total_play_time += frame_time;
+
+  // Calculate difficulty level
+  int difficulty_level = (int)(game->total_play_time / 30.0f);
+
+  game->step++;
+  game->input_count = 0;
+
+  // Explosions keep playing out after the player dies
+  update_particles(&game->particles, frame_time);
+
+  if (!game->player_is_alive)
+    return;
+
+  for (int i = 0; i < input->spawn_requests; i++) {
+    // Add new enemy at random position
+    float random_x = (rand() % 700) + 50.0f;
+    float random_y = (rand() % 500) + 50.0f;
+    add_enemy_to_manager(enemies, random_x, random_y, 1, difficulty_level);
+    printf("New enemy added! Total enemies: %d\n",
+           enemies->current_enemy_count);
+  }
+
+  // Automatic enemy spawning over time (increasing difficulty)
+  game->enemy_spawn_timer += frame_time;
+  spawn_timed_enemy(game, difficulty_level);
+
+  // Process player movement, remembering where the step started so shots
+  // can be fired from where the player was at the time
+  float start_x = game->player_x;
+  float start_y = game->player_y;
+  float move_x = 0.0f, move_y = 0.0f;
+
+  if (input->keys & INPUT_KEY_UP)
+    move_y -= 1.0f;
+  if (input->keys & INPUT_KEY_DOWN)
+    move_y += 1.0f;
+  if (input->keys & INPUT_KEY_LEFT)
+    move_x -= 1.0f;
+  if (input->keys & INPUT_KEY_RIGHT)
+    move_x += 1.0f;
+
+  // Fix diagonal movement speed
+  if (move_x != 0.0f && move_y != 0.0f) {
+    move_x *= 0.7071f;
+    move_y *= 0.7071f;
+  }
+
+  // Update player position, per second like the enemies so the pace
+  // doesn't follow the frame rate
+  game->player_x += move_x * game->player_speed * frame_time;
+  game->player_y += move_y * game->player_speed * frame_time;
+
+  // Keep player within window bounds
+  if (game->player_x < 0)
+    game->player_x = 0;
+  if (game->player_x + game->player_width > game->window_w)
+    game->player_x = game->window_w - game->player_width;
+  if (game->player_y < 0)
+    game->player_y = 0;
+  if (game->player_y + game->player_height > game->window_h)
+    game->player_y = game->window_h - game->player_height;
+
+  // Key presses and releases show once the direction of travel changes
+  if (move_x != game->last_move_x || move_y != game->last_move_y) {
+    for (int i = 0; i < input->move_count; i++)
+      game->input_times[game->input_count++] = input->move_times[i];
+    game->last_move_x = move_x;
+    game->last_move_y = move_y;
+  }
+
+  // Shots, each at its moment within the step
+  for (int i = 0; i < input->shot_count; i++) {
+    const ShotCommand *shot = &input->shots[i];
+    float fraction = step_fraction(input, shot->timestamp);
+    float origin_x = start_x + (game->player_x - start_x) * fraction +
+                     game->player_width / 2;
+    float origin_y = start_y + (game->player_y - start_y) * fraction +
+                     game->player_height / 2;
+    int fired = game->projectile_count;
+    fire_player_shot(game, origin_x, origin_y, shot->aim_x, shot->aim_y,
+                     fraction * frame_time);
+    if (game->projectile_count > fired)
+      game->input_times[game->input_count++] = shot->timestamp;
+  }
+
+  // Update enemy positions (they chase player)
+  update_all_enemies(enemies, game->player_x, game->player_y, frame_time,
+                     game->player_x, game->player_y, game->player_width,
+                     game->player_height);
+
+  // Update projectiles
+  update_player_projectiles(game->projectiles, &game->projectile_count,
+                            MAX_PLAYER_PROJECTILES, enemies, &game->score,
+                            game->window_w, game->window_h,
+                            game->enemy_projectiles, &game->enemy_proj_count,
+                            MAX_ENEMY_PROJECTILES, frame_time, game->upgrades,
+                            game->audio);
+  update_enemy_projectiles(game->enemy_projectiles, &game->enemy_proj_count,
+                           MAX_ENEMY_PROJECTILES, game->player_x,
+                           game->player_y, game->player_width,
+                           game->player_height, &game->player_health,
+                           game->window_w, game->window_h, frame_time);
+
+  // Handle collision damage between player and enemies
+  float damage_taken = handle_player_enemy_collision_damage(
+      enemies, game->player_x, game->player_y, game->player_width,
+      game->player_height, &game->score, game->audio);
+  game->player_health -= damage_taken;
+
+  // Enemies that died this step: start their explosion, spawn what they
+  // leave behind and take them out of the store right away
+  int dead_count = enemies->current_enemy_count;
+  for (int j = 0; j < dead_count; j++) {
+    Enemy *e = &enemies->enemies_array[j];
+    if (e->is_alive)
+      continue;
+    spawn_explosion(&game->particles, e->position_x + e->width / 2,
+                    e->position_y + e->height / 2, e->width, e->enemy_type,
+                    game->explosion_particles);
+    if (e->enemy_type == 2 && !e->has_spawned_death_projectiles) {
+      spawn_purple_enemy_death_projectiles(e, game->enemy_projectiles,
+                                           &game->enemy_proj_count,
+                                           MAX_ENEMY_PROJECTILES);
+    }
+    if (e->enemy_type == 3 && !e->has_spawned_minions) {
+      // Spawn 5 fast small cube enemies
+      for (int k = 0; k < 5; k++) {
+        float minion_x = e->position_x + (rand() % 100) - 50;
+        float minion_y = e->position_y + (rand() % 100) - 50;
+        add_enemy_to_manager(enemies, minion_x, minion_y, 4,
+                             difficulty_level);
+      }
+      e->has_spawned_minions = 1;
+    }
+  }
+  cleanup_dead_enemies(enemies);
+
+  // Check if player died
+  if (game->player_health <= 0) {
+    game->player_health = 0;
+    game->player_is_alive = 0;
+  }
+}
+
+void build_game_snapshot(GameState *game, GameSnapshot *snapshot) {
+  RenderCommandBuffer *commands = &snapshot->commands;
+  render_commands_clear(commands);
+
+  if (game->player_is_alive) {
+    // Draw player as red square
+    SDL_Color player_color = {255, 0, 0, 255};
+    emit_quad(commands, RENDER_LAYER_PLAYER, game->player_x, game->player_y,
+              game->player_width, game->player_height, player_color);
+    emit_quad(commands, RENDER_LAYER_HUD, 10, 10, game->player_health, 20,
+              player_color);
+  }
+
+  // Draw all enemies and explosions
+  draw_all_enemies(&game->enemies, commands);
+  draw_particles(&game->particles, commands);
+
+  // Draw projectiles
+  draw_player_projectiles(game->projectiles, game->projectile_count, commands);
+  draw_enemy_projectiles(game->enemy_projectiles, game->enemy_proj_count,
+                         commands);
+
+  // Draw score on the right side
+  if (game->score != game->hud_score) {
+    sprintf(game->score_text, "SCORE: %d", game->score);
+    game->hud_score = game->score;
+  }
+  SDL_Color score_color = {255, 255, 255, 255}; // White
+  emit_text(commands, RENDER_LAYER_HUD, game->score_text, game->window_w - 280,
+            10, score_color, 2.0f);
+
+  snapshot->score = game->score;
+  snapshot->player_is_alive = game->player_is_alive;
+  snapshot->enemy_count = game->enemies.current_enemy_count;
+  snapshot->step = game->step;
+  snapshot->input_count = game->input_count;
+  memcpy(snapshot->input_times, game->input_times,
+         sizeof(Uint32) * game->input_count);
+}
@@ -0,0 +1,102 @@
+#ifndef GAME_H
+#define GAME_H
+
+#include "arena.h"
+#include "audio.h"
+#include "enemy.h"
+#include "governor.h"
+#include "input.h"
+#include "particles.h"
+#include "projectile.h"
+#include "renderCommands.h"
+#include "upgrades.h"
+#include <SDL2/SDL.h>
+
+// Shots and debug spawns that can queue up between two simulation steps
+#define MAX_QUEUED_SHOTS 8
+// Movement key presses and releases tracked for latency per step
+#define MAX_QUEUED_MOVES 8
+#define MAX_STEP_INPUTS (MAX_QUEUED_SHOTS + MAX_QUEUED_MOVES)
+// Draw commands one snapshot can hold
+#define SNAPSHOT_COMMANDS 8192
+
+// A shot fired between two steps, with when it was fired
+typedef struct {
+  float aim_x, aim_y; // Aim point, logical coordinates
+  Uint32 timestamp;   // SDL event time (ms)
+} ShotCommand;
+
+// Everything the simulation needs from the main thread for one step. The
+// main thread fills it from SDL events, the simulation only reads it.
+typedef struct {
+  float frame_time;
+  Uint32 step_start, step_end; // Event time span this step covers (ms)
+  int window_w, window_h;
+  Uint32 keys; // InputKey bits held
+  int shot_count;
+  ShotCommand shots[MAX_QUEUED_SHOTS];
+  int spawn_requests; // Debug enemy spawns (space bar)
+  int move_count;
+  Uint32 move_times[MAX_QUEUED_MOVES]; // Movement key event times (ms)
+  QualitySettings quality;
+} GameInput;
+
+// Immutable view of one simulation step, handed to the render thread
+typedef struct {
+  RenderCommandBuffer commands; // Player, enemies, projectiles and HUD
+  int score;
+  int player_is_alive;
+  int enemy_count;
+  Uint32 step; // Simulation step the snapshot was taken after
+  int input_count;
+  Uint32 input_times[MAX_STEP_INPUTS]; // Events whose effect first shows
+                                       // in this snapshot (ms)
+} GameSnapshot;
+
+// Gameplay state. Owned by the simulation; the main thread only touches it
+// while no step is running.
+typedef struct {
+  float player_x, player_y;
+  float player_width, player_height;
+  float player_speed; // Pixels per second
+  float player_health;
+  int player_is_alive;
+  int score;
+
+  EnemyManager enemies;
+  ParticleSystem particles; // Explosions, outliving the enemies they came from
+  int explosion_particles;  // Debris per explosion (quality setting)
+  Projectile *projectiles;
+  int projectile_count;
+  EnemyProjectile *enemy_projectiles;
+  int enemy_proj_count;
+
+  float enemy_spawn_timer;
+  int enemies_spawned_count;
+  float total_play_time;
+  int window_w, window_h;
+
+  PlayerUpgrades *upgrades;
+  VoiceManager *audio;
+
+  // Input latency tracking: the step counter, the movement direction of the
+  // previous step and the events that took visible effect in this one
+  Uint32 step;
+  float last_move_x, last_move_y;
+  int input_count;
+  Uint32 input_times[MAX_STEP_INPUTS];
+
+  // HUD score text, only re-formatted when the score changes
+  char score_text[20];
+  int hud_score;
+} GameState;
+
+// Function declarations
+int initialize_game(GameState *game, Arena *arena, PlayerUpgrades *upgrades,
+                    VoiceManager *audio);
+void new_game(GameState *game);
+void clear_game_input(GameInput *input);
+void update_game(GameState *game, const GameInput *input);
+void build_game_snapshot(GameState *game, GameSnapshot *snapshot);
+
+#endif
@@ -0,0 +1,97 @@
+#include "governor.h"
+#include <stdio.h>
+
+// Step down when the percentile is over budget, up only when it is well
+// under, so a level that just fits doesn't flip back and forth
+#define OVER_BUDGET 1.0f
+#define UNDER_BUDGET 0.7f
+#define STEP_DOWN_COOLDOWN 30
+#define STEP_UP_COOLDOWN 180
+
+// Each level keeps everything the previous one gave up
+static const QualitySettings quality_levels[] = {
+    // scale particles bars stars lod
+    {1.00f, 12, 1, 1.00f, 0.0f}, // Full quality
+    {0.75f, 12, 1, 1.00f, 0.0f},
+    {0.50f, 12, 1, 1.00f, 0.0f},
+    {0.50f, 6, 1, 1.00f, 0.0f},
+    {0.50f, 0, 1, 1.00f, 0.0f},
+    {0.50f, 0, 0, 1.00f, 0.0f},
+    {0.50f, 0, 0, 0.50f, 0.0f},
+    {0.50f, 0, 0, 0.25f, 0.0f},
+    {0.50f, 0, 0, 0.25f, 400.0f},
+    {0.50f, 0, 0, 0.25f, 200.0f},
+};
+
+#define QUALITY_LEVEL_COUNT                                                    \
+  ((int)(sizeof(quality_levels) / sizeof(quality_levels[0])))
+
+void governor_init(Governor *governor, float budget_ms, int enabled) {
+  governor->frame_count = 0;
+  governor->next_frame = 0;
+  governor->budget_ms = budget_ms;
+  governor->percentile_ms = 0.0f;
+  governor->level = 0;
+  governor->cooldown = 0;
+  governor->enabled = enabled;
+}
+
+// 95th percentile of the recorded frames (insertion sort of a copy; the
+// history is small)
+static float frame_percentile(const Governor *governor) {
+  float sorted[GOVERNOR_HISTORY];
+  int count = governor->frame_count;
+  for (int i = 0; i < count; i++) {
+    float value = governor->frame_ms[i];
+    int j = i;
+    while (j > 0 && sorted[j - 1] > value) {
+      sorted[j] = sorted[j - 1];
+      j--;
+    }
+    sorted[j] = value;
+  }
+  return sorted[(count - 1) * 95 / 100];
+}
+
+static void change_level(Governor *governor, int level, int cooldown) {
+  printf("Quality level %d -> %d (p95 %.1f ms, budget %.1f ms)\n",
+         governor->level, level, governor->percentile_ms,
+         governor->budget_ms);
+  governor->level = level;
+  governor->cooldown = cooldown;
+  // Judge the new level on its own frames only
+  governor->frame_count = 0;
+  governor->next_frame = 0;
+}
+
+void governor_record_frame(Governor *governor, float frame_ms) {
+  governor->frame_ms[governor->next_frame] = frame_ms;
+  governor->next_frame = (governor->next_frame + 1) % GOVERNOR_HISTORY;
+  if (governor->frame_count < GOVERNOR_HISTORY)
+    governor->frame_count++;
+  governor->percentile_ms = frame_percentile(governor);
+
+  if (!governor->enabled)
+    return;
+  if (governor->cooldown > 0) {
+    governor->cooldown--;
+    return;
+  }
+
+  // Half a window is enough to react to a spike; recovering needs a full one
+  if (governor->frame_count >= GOVERNOR_HISTORY / 2 &&
+      governor->percentile_ms > governor->budget_ms * OVER_BUDGET &&
+      governor->level < QUALITY_LEVEL_COUNT - 1) {
+    change_level(governor, governor->level + 1, STEP_DOWN_COOLDOWN);
+  } else if (governor->frame_count >= GOVERNOR_HISTORY &&
+             governor->percentile_ms < governor->budget_ms * UNDER_BUDGET &&
+             governor->level > 0) {
+    change_level(governor, governor->level - 1, STEP_UP_COOLDOWN);
+  }
+}
+
+const QualitySettings *governor_quality(const Governor *governor) {
+  return &quality_levels[governor->level];
+}
+
+int governor_level_count(void) { return QUALITY_LEVEL_COUNT; }
@@ -0,0 +1,37 @@
+#ifndef GOVERNOR_H
+#define GOVERNOR_H
+
+// Frames of history the frame-time percentile is taken over
+#define GOVERNOR_HISTORY 60
+
+// Quality knobs, in the order the governor gives them up
+typedef struct {
+  float render_scale;      // Upper bound for the world render scale
+  int explosion_particles; // Particles per explosion
+  int health_bars;         // Per-enemy health bars
+  float starfield_density; // Fraction of the parallax stars drawn
+  float sim_lod_distance;  // Enemies further away skip avoidance, 0 = off
+} QualitySettings;
+
+// Frame-budget governor. Watches the 95th percentile of recent frame work
+// times and steps quality down when it is over budget, back up when there
+// is clear headroom. Levels only change after a cooldown so it doesn't
+// oscillate.
+typedef struct {
+  float frame_ms[GOVERNOR_HISTORY]; // Ring of recent frame work times
+  int frame_count;                  // Valid entries since the last change
+  int next_frame;
+  float budget_ms;
+  float percentile_ms; // Last 95th percentile
+  int level;           // 0 = full quality
+  int cooldown;        // Frames until the level may change again
+  int enabled;
+} Governor;
+
+// Function declarations
+void governor_init(Governor *governor, float budget_ms, int enabled);
+void governor_record_frame(Governor *governor, float frame_ms);
+const QualitySettings *governor_quality(const Governor *governor);
+int governor_level_count(void);
+
+#endif
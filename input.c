@@ -0,0 +1,74 @@
+#include "input.h"
+
+// Events pulled off the queue per SDL_PeepEvents call
+#define MOTION_BATCH 64
+
+void input_init(InputState *input) {
+  input->keys = 0;
+  input->latched_keys = 0;
+  input->mouse_x = 0;
+  input->mouse_y = 0;
+  input->motion_merged = 0;
+}
+
+// Take every pending motion event off the queue and keep only the newest
+// position. Clicks and keys stay queued, in order, with their timestamps.
+// Call once per frame before polling.
+void input_coalesce_motion(InputState *input) {
+  SDL_Event events[MOTION_BATCH];
+  int taken;
+  input->motion_merged = 0;
+  SDL_PumpEvents();
+  do {
+    taken = SDL_PeepEvents(events, MOTION_BATCH, SDL_GETEVENT,
+                           SDL_MOUSEMOTION, SDL_MOUSEMOTION);
+    if (taken > 0) {
+      input_note_motion(input, &events[taken - 1].motion);
+      input->motion_merged += taken;
+    }
+  } while (taken == MOTION_BATCH);
+}
+
+void input_note_motion(InputState *input, const SDL_MouseMotionEvent *motion) {
+  input->mouse_x = motion->x;
+  input->mouse_y = motion->y;
+}
+
+Uint32 input_key_bit(SDL_Keycode key) {
+  switch (key) {
+  case SDLK_w:
+    return INPUT_KEY_UP;
+  case SDLK_s:
+    return INPUT_KEY_DOWN;
+  case SDLK_a:
+    return INPUT_KEY_LEFT;
+  case SDLK_d:
+    return INPUT_KEY_RIGHT;
+  case SDLK_ESCAPE:
+    return INPUT_KEY_ESCAPE;
+  default:
+    return 0;
+  }
+}
+
+void input_handle_key(InputState *input, const SDL_KeyboardEvent *key) {
+  Uint32 bit = input_key_bit(key->keysym.sym);
+  if (key->type == SDL_KEYDOWN) {
+    input->keys |= bit;
+  } else {
+    input->keys &= ~bit;
+  }
+}
+
+// Keys that went down since the previous call
+Uint32 input_take_presses(InputState *input) {
+  Uint32 pressed = input->keys & ~input->latched_keys;
+  input->latched_keys = input->keys;
+  return pressed;
+}
+
+// Forget everything held, e.g. when a new game starts
+void input_release_all(InputState *input) {
+  input->keys = 0;
+  input->latched_keys = 0;
+}
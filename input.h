@@ -0,0 +1,36 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <SDL2/SDL.h>
+
+// Held keys as bits
+typedef enum {
+  INPUT_KEY_UP = 1 << 0,
+  INPUT_KEY_DOWN = 1 << 1,
+  INPUT_KEY_LEFT = 1 << 2,
+  INPUT_KEY_RIGHT = 1 << 3,
+  INPUT_KEY_ESCAPE = 1 << 4
+} InputKey;
+
+// Input layer in front of the event pump. Mouse motion is coalesced before
+// the events are dispatched, so a 1000 Hz mouse costs one queue sweep per
+// frame instead of hundreds of trips through the menu and gameplay
+// handlers. Key state is kept as a bitset the simulation input is built
+// from once per tick.
+typedef struct {
+  Uint32 keys;          // InputKey bits currently held
+  Uint32 latched_keys;  // Keys held at the last input_take_presses
+  int mouse_x, mouse_y; // Newest motion position, window coordinates
+  int motion_merged;    // Motion events coalesced this frame
+} InputState;
+
+// Function declarations
+void input_init(InputState *input);
+void input_coalesce_motion(InputState *input);
+void input_note_motion(InputState *input, const SDL_MouseMotionEvent *motion);
+Uint32 input_key_bit(SDL_Keycode key);
+void input_handle_key(InputState *input, const SDL_KeyboardEvent *key);
+Uint32 input_take_presses(InputState *input);
+void input_release_all(InputState *input);
+
+#endif
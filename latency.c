@@ -0,0 +1,63 @@
+#include "latency.h"
+#include <stdio.h>
+#include <string.h>
+
+#define REPORT_BAR_WIDTH 50
+
+void latency_init(LatencyHistogram *histogram) {
+  memset(histogram, 0, sizeof(*histogram));
+}
+
+void latency_record(LatencyHistogram *histogram, Uint32 latency_ms) {
+  int bucket = latency_ms < LATENCY_BUCKETS ? (int)latency_ms
+                                            : LATENCY_BUCKETS - 1;
+  histogram->buckets[bucket]++;
+  histogram->count++;
+  histogram->total_ms += latency_ms;
+  if (latency_ms > histogram->worst_ms)
+    histogram->worst_ms = latency_ms;
+}
+
+// Smallest latency (ms) that at least percent of the inputs stayed under
+int latency_percentile(const LatencyHistogram *histogram, int percent) {
+  if (histogram->count == 0)
+    return 0;
+  Uint32 wanted = (Uint32)(((Uint64)histogram->count * percent + 99) / 100);
+  Uint32 seen = 0;
+  for (int i = 0; i < LATENCY_BUCKETS; i++) {
+    seen += histogram->buckets[i];
+    if (seen >= wanted)
+      return i;
+  }
+  return LATENCY_BUCKETS - 1;
+}
+
+// Print the summary and the histogram as text bars
+void latency_report(const LatencyHistogram *histogram) {
+  if (histogram->count == 0)
+    return;
+  printf("Input latency: %u inputs, mean %.1f ms, p50 %d ms, p95 %d ms, "
+         "p99 %d ms, worst %u ms\n",
+         histogram->count, (double)histogram->total_ms / histogram->count,
+         latency_percentile(histogram, 50), latency_percentile(histogram, 95),
+         latency_percentile(histogram, 99), histogram->worst_ms);
+
+  Uint32 largest = 0;
+  for (int i = 0; i < LATENCY_BUCKETS; i++) {
+    if (histogram->buckets[i] > largest)
+      largest = histogram->buckets[i];
+  }
+  for (int i = 0; i < LATENCY_BUCKETS; i++) {
+    if (histogram->buckets[i] == 0)
+      continue;
+    char bar[REPORT_BAR_WIDTH + 1];
+    int length = (int)((Uint64)histogram->buckets[i] * REPORT_BAR_WIDTH /
+                       largest);
+    if (length < 1)
+      length = 1;
+    memset(bar, '#', length);
+    bar[length] = '\0';
+    printf("  %3d%s ms %6u %s\n", i, i == LATENCY_BUCKETS - 1 ? "+" : " ",
+           histogram->buckets[i], bar);
+  }
+}
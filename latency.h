@@ -0,0 +1,25 @@
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <SDL2/SDL.h>
+
+// One bucket per millisecond; slower inputs all land in the last bucket
+#define LATENCY_BUCKETS 100
+
+// Input-to-present latency histogram. Every mouse click and movement key
+// event is followed through the simulation to the first presented frame
+// that shows its effect, and the time in between is recorded here.
+typedef struct {
+  Uint32 buckets[LATENCY_BUCKETS];
+  Uint32 count;
+  Uint64 total_ms;
+  Uint32 worst_ms;
+} LatencyHistogram;
+
+// Function declarations
+void latency_init(LatencyHistogram *histogram);
+void latency_record(LatencyHistogram *histogram, Uint32 latency_ms);
+int latency_percentile(const LatencyHistogram *histogram, int percent);
+void latency_report(const LatencyHistogram *histogram);
+
+#endif
@@ -1,8 +1,29 @@
+#include "arena.h"
+#include "assetPack.h"
+#include "audio.h"
+#include "background.h"
+#include "debugOverlay.h"
 #include "dieMenu.h"
 #include "enemy.h"
+#include "framePacer.h"
+#include "game.h"
+#include "governor.h"
+#include "input.h"
+#include "latency.h"
 #include "mainMenu.h"
-#include "projectile.h"
+#include "memtrack.h"
+#include "musicStream.h"
+#include "options.h"
+#include "renderBatch.h"
+#include "renderCommands.h"
+#include "renderView.h"
+#include "simPipeline.h"
+#include "soundBank.h"
 #include "soundMenu.h"
+#include "spriteCache.h"
+#include "swrast.h"
+#include "text.h"
+#include "uiCache.h"
 #include "upgradeMenu.h"
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_mixer.h>
@@ -29,11 +50,20 @@ int load_coins() {
   return coins;
 }
 
-// Forward declaration for draw_text function
-void draw_text(SDL_Renderer *renderer, const char *text, float x, float y,
-               SDL_Color color, float scale);
+// Gameplay frames to let SDL's internal buffers settle before the
+// zero-allocation check kicks in (tracking builds only)
+#define ALLOC_CHECK_WARMUP_FRAMES 120
+
+// Longest an idle loop blocks waiting for an event
+#define IDLE_WAIT_MS 500
 
 int main(int argc, char *argv[]) {
+   // Route SDL's allocations through the tracker before SDL allocates anything
+   memtrack_install_sdl_hooks();
+
+   GameOptions options;
+   parse_game_options(&options, argc, argv);
+
    // Set render scale quality
    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "linear");
 
@@ -43,12 +73,14 @@ int main(int argc, char *argv[]) {
      return -1;
    }
 
-   // Initialize SDL_mixer
-   if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
-     printf("SDL_mixer could not initialize! SDL_mixer Error: %s\n", Mix_GetError());
+   // Initialize SDL_mixer. Every sound effect goes through the voice
+   // manager, which also watches the device for underruns and can mix the
+   // effects itself.
+   VoiceManager voices;
+   if (!audio_open(&voices, options.audio_rate, options.audio_buffer,
+                   options.software_mix)) {
      return -1;
    }
-   Mix_AllocateChannels(16); // Allow more simultaneous sound channels
 
 #ifdef _WIN32
     // Get screen size for initial window size on Windows
@@ -72,8 +104,25 @@ int main(int argc, char *argv[]) {
      return -1;
    }
 
-   // Create graphics renderer
-   SDL_Renderer *graphics_renderer = SDL_CreateRenderer(game_window, -1, SDL_RENDERER_ACCELERATED);
+   // Create graphics renderer. Without a GPU (or when asked to) the world is
+   // rasterized by our own software rasterizer and SDL only presents it.
+   int use_swrast = options.software_renderer;
+   Uint32 vsync_flag =
+       options.pacing == PACE_VSYNC ? SDL_RENDERER_PRESENTVSYNC : 0;
+   SDL_Renderer *graphics_renderer = NULL;
+   if (!use_swrast) {
+     graphics_renderer = SDL_CreateRenderer(
+         game_window, -1, SDL_RENDERER_ACCELERATED | vsync_flag);
+     if (!graphics_renderer) {
+       printf("Warning: No accelerated renderer (%s), using software\n",
+              SDL_GetError());
+       use_swrast = 1;
+     }
+   }
+   if (!graphics_renderer) {
+     graphics_renderer = SDL_CreateRenderer(game_window, -1,
+                                            SDL_RENDERER_SOFTWARE | vsync_flag);
+   }
    if (!graphics_renderer) {
      printf("Error: Could not create renderer\n");
      SDL_DestroyWindow(game_window);
@@ -81,67 +130,94 @@ int main(int argc, char *argv[]) {
      return -1;
    }
 
+  // Frame pacing. Vsync needs a renderer that can do it; otherwise hold the
+  // display's refresh rate ourselves.
+  SDL_DisplayMode display_mode;
+  int refresh_rate = 60;
+  if (SDL_GetDesktopDisplayMode(0, &display_mode) == 0 &&
+      display_mode.refresh_rate > 0) {
+    refresh_rate = display_mode.refresh_rate;
+  }
+  PaceMode pacing = options.pacing;
+  SDL_RendererInfo renderer_info;
+  if (pacing == PACE_VSYNC &&
+      (SDL_GetRendererInfo(graphics_renderer, &renderer_info) != 0 ||
+       !(renderer_info.flags & SDL_RENDERER_PRESENTVSYNC))) {
+    printf("Warning: No vsync, pacing frames at %d FPS instead\n",
+           refresh_rate);
+    pacing = PACE_TARGET_FPS;
+  }
+  FramePacer pacer;
+  frame_pacer_init(&pacer, pacing,
+                   pacing == PACE_TARGET_FPS && options.target_fps > 0.0f
+                       ? options.target_fps
+                       : (float)refresh_rate);
+
   // Hide the mouse cursor
   SDL_ShowCursor(0);
 
-  // Load sound effects with SDL_mixer
-   Mix_Chunk *shoot_sound = Mix_LoadWAV("shoot.wav");
-   if (!shoot_sound) {
-     printf("Warning: Could not load shoot.wav: %s\n", Mix_GetError());
-   } else {
-      Mix_VolumeChunk(shoot_sound, 16); // Quieter shooting sound
-   }
-
-   Mix_Chunk *explode_sound = Mix_LoadWAV("enemy_explode.wav");
-   if (!explode_sound) {
-     printf("Warning: Could not load enemy_explode.wav: %s\n", Mix_GetError());
-   } else {
-      Mix_VolumeChunk(explode_sound, 128); // Louder explosion sound
-   }
+  // Game-lifetime and per-frame memory plus the text atlas and sprites, set
+  // up once
+  if (!arena_init(&game_arena, GAME_ARENA_SIZE) ||
+      !arena_init(&frame_arena, FRAME_ARENA_SIZE) ||
+      !text_init(graphics_renderer, &game_arena) ||
+      !sprite_cache_init(graphics_renderer, &game_arena)) {
+    SDL_DestroyRenderer(graphics_renderer);
+    SDL_DestroyWindow(game_window);
+    SDL_Quit();
+    return -1;
+  }
 
-  Mix_Music *bg_music = Mix_LoadMUS("bg_music.wav");
+  // Assets come from the pack next to the executable (or linked into it),
+  // so the working directory doesn't matter
+  AssetPack assets;
+  asset_pack_open(&assets, "assets.pak");
+
+  // Load sound effects, converted once to the device format
+  SoundBank sound_bank;
+  sound_bank_init(&sound_bank);
+  Mix_Chunk *shoot_sound =
+      sound_bank_load(&sound_bank, SOUND_SHOOT, &assets, "shoot.wav");
+  Mix_Chunk *explode_sound = sound_bank_load(&sound_bank, SOUND_EXPLODE,
+                                             &assets, "enemy_explode.wav");
+
+  // Quiet shots give way to explosions; merged explosions can still get
+  // louder than a single one
+  audio_set_sound(&voices, SOUND_SHOOT, shoot_sound, 1, 4, 16);
+  audio_set_sound(&voices, SOUND_EXPLODE, explode_sound, 2, 6, 96);
+
+  // Stream the music, compressed if there is an OGG, else the old WAV
+  MusicStream music_stream;
+  Mix_Music *bg_music = music_stream_open(
+      &music_stream, asset_pack_open_rw(&assets, "bg_music.ogg"));
+  if (!bg_music) {
+    bg_music = music_stream_open(&music_stream,
+                                 asset_pack_open_rw(&assets, "bg_music.wav"));
+  }
   if (!bg_music) {
-    printf("Warning: Could not load bg_music.wav: %s\n", Mix_GetError());
+    printf("Warning: Could not load bg_music.ogg or bg_music.wav\n");
   }
 
    // Play background music (loop)
-   if (bg_music) {
-     Mix_PlayMusic(bg_music, -1);
-     Mix_VolumeMusic(128); // Max volume for background music
-   }
+   audio_play_music(&voices, bg_music);
 
   // Game state variables
   int game_running = 1;
   SDL_Event current_event;
-  int player_score = 0;
   int player_coins = load_coins();
-
-  // Player information
-  float player_x = 200.0f;
-  float player_y = 100.0f;
-  float player_width = 50.0f;
-  float player_height = 50.0f;
-  float player_speed = 5.0f;
-  float player_health = 200.0f;
-  int player_is_alive = 1;
-  int key_up = 0, key_down = 0, key_left = 0, key_right = 0;
-
-  // Enemy system setup
-  EnemyManager enemies;
-  initialize_enemy_manager(&enemies, 1000); // Room for 10 enemies
-
-  // Create starting enemies
-  add_enemy_to_manager(&enemies, 400.0f, 300.0f, 1, 0); // Middle
-  add_enemy_to_manager(&enemies, 100.0f, 100.0f, 1, 0); // Top-left
-  add_enemy_to_manager(&enemies, 600.0f, 400.0f, 1, 0); // Bottom-right
-  add_enemy_to_manager(&enemies, 200.0f, 500.0f, 1, 0); // Bottom-left
-
-  // Timing for smooth movement
-  Uint64 last_frame_time = SDL_GetTicks();
-
-  float enemy_spawn_timer = 0.0f;
-  int enemies_spawned_count = 0;
-  float total_play_time = 0.0f;
+  InputState input;
+  input_init(&input);
+
+  // Quad batch shared by the background and the game world, and the command
+  // buffer the world is described in before it is culled, sorted and batched.
+  // It holds a full snapshot plus the background and every star.
+  RenderBatch world_batch;
+  render_batch_init(&world_batch, graphics_renderer, &game_arena, 4096);
+  RenderCommandBuffer world_commands;
+  render_commands_init(&world_commands, &game_arena,
+                       SNAPSHOT_COMMANDS + BACKGROUND_STAR_COUNT + 1 +
+                           (options.starfield ? options.starfield_stars : 0));
+  int warned_dropped = 0;
 
   // Add DieMenu after your existing variables
   DieMenu game_over_menu;
@@ -156,8 +232,6 @@ int main(int argc, char *argv[]) {
     int show_upgrades = 0;
     int show_sound = 0;
    int is_paused = 0; // 1 if paused from game, 0 if from main menu
-   int key_esc = 0;
-   int key_esc_prev = 0;
 
    // Upgrades
    PlayerUpgrades player_upgrades;
@@ -169,64 +243,144 @@ int main(int argc, char *argv[]) {
    SoundMenu sound_menu;
    initialize_sound_menu(&sound_menu);
 
-  // Projectile system
-  Projectile projectiles[30];
-  int projectile_count = 0;
-  for (int i = 0; i < 30; i++)
-    projectiles[i].alive = 0;
-
-  // Enemy projectile system
-  EnemyProjectile enemy_projectiles[50];
-  int enemy_proj_count = 0;
-  for (int i = 0; i < 50; i++)
-    enemy_projectiles[i].alive = 0;
+   // Retained UI: one cached target shared by whichever menu is open
+   UiPanel menu_panel;
+   ui_panel_init(&menu_panel);
+
+  // Gameplay state (player, enemies, projectiles), stepped by the simulation
+  // pipeline and drawn from the snapshots it publishes
+  GameState game;
+  SimPipeline sim;
+  if (!initialize_game(&game, &game_arena, &player_upgrades, &voices) ||
+      !sim_pipeline_init(&sim, &game, &game_arena, SNAPSHOT_COMMANDS,
+                         options.sim_thread)) {
+    printf("Error: Could not set up the game state\n");
+    SDL_DestroyRenderer(graphics_renderer);
+    SDL_DestroyWindow(game_window);
+    SDL_Quit();
+    return -1;
+  }
+  GameInput game_input;
+  clear_game_input(&game_input);
 
-  // Mouse position
-  float mouse_x = 400.0f;
-  float mouse_y = 300.0f;
+  // Input-to-present latency, measured on the snapshots actually shown
+  LatencyHistogram latency;
+  latency_init(&latency);
+  Uint32 latency_step = 0; // Last snapshot whose inputs were recorded
+  const GameSnapshot *presented = NULL;
 
   // Window size for bounds
   int window_w = 800;
   int window_h = 600;
 
-  // Star positions for background
-  float star_x[100];
-  float star_y[100];
-  int prev_window_w = 800;
-  int prev_window_h = 600;
+  // Internal resolution the world is drawn at before it is scaled to the
+  // window. Gameplay and the mouse work in its logical coordinates.
+  RenderView view;
+  render_view_init(&view, options.logical_w, options.logical_h,
+                   options.render_scale, options.linear_filter);
+
+  // Consecutive gameplay frames, for the zero-allocation check
+  int gameplay_frames = 0;
+
+  // Quality governor and the F3 overlay showing what it is doing
+  Governor governor;
+  governor_init(&governor, options.frame_budget_ms, options.governor);
+  int show_debug = 0;
+  float smoothed_fps = 0.0f;
+
+  // Cached background and the optional parallax starfield
+  Background background;
+  initialize_background(&background);
+  Starfield starfield;
+  starfield.count = 0;
+  if (options.starfield) {
+    initialize_starfield(&starfield, &game_arena, options.starfield_stars);
+  }
+
+  // Tile rasterizer for the world when running without a GPU
+  SoftwareRenderer swrast;
+  if (use_swrast) {
+    swrast_init(&swrast, options.raster_threads);
+  }
+
+  // Set whenever the idle screen may have changed and has to be drawn again
+  int needs_redraw = 1;
+
+  // When the previous frame's events were collected
+  Uint32 input_time = SDL_GetTicks();
 
   // Main game loop
   while (game_running) {
-    // Calculate time since last frame
-    Uint64 current_time = SDL_GetTicks();
-    float frame_time = (current_time - last_frame_time) / 1000.0f;
-    last_frame_time = current_time;
+    // Nothing animates in the menus or while paused, and nothing is shown
+    // while the window is minimized, so block until something happens
+    // instead of spinning
+    Uint32 window_flags = SDL_GetWindowFlags(game_window);
+    int window_visible =
+        !(window_flags & (SDL_WINDOW_HIDDEN | SDL_WINDOW_MINIMIZED));
+    int idle = !window_visible || main_menu.is_active ||
+               upgrade_menu.is_active || sound_menu.is_active ||
+               game_over_menu.is_active;
+    int have_event = 0;
+    if (idle && !needs_redraw) {
+      have_event = SDL_WaitEventTimeout(&current_event, IDLE_WAIT_MS);
+      if (have_event && current_event.type == SDL_MOUSEMOTION) {
+        // Nothing idle reacts to motion; don't redraw for it
+        input_note_motion(&input, &current_event.motion);
+        have_event = 0;
+      }
+      frame_pacer_reset(&pacer);
+    }
+
+    // This frame's events happened since the previous frame's pump
+    Uint32 previous_input_time = input_time;
+    input_time = SDL_GetTicks();
 
-    // Update total play time
-    total_play_time += frame_time;
+    // Time since last frame, as measured by the pacer
+    float frame_time = frame_pacer_frame_time(&pacer);
+    Uint64 frame_start = SDL_GetPerformanceCounter();
 
-    // Calculate difficulty level
-    int difficulty_level = (int)(total_play_time / 30.0f);
+    // Everything in the scratch arena only lives for one frame
+    arena_reset(&frame_arena);
+    memtrack_begin_frame();
 
       // Update window size
       SDL_GetWindowSize(game_window, &window_w, &window_h);
       // Ensure viewport covers the entire renderer
       SDL_RenderSetViewport(graphics_renderer, NULL);
-
-    // Regenerate stars if window size changed
-    if (window_w != prev_window_w || window_h != prev_window_h) {
-      for (int i = 0; i < 100; i++) {
-        star_x[i] = rand() % window_w;
-        star_y[i] = rand() % window_h;
-      }
-      prev_window_w = window_w;
-      prev_window_h = window_h;
-    }
-
-    // Handle input events
-    while (SDL_PollEvent(&current_event)) {
+      render_view_update(&view, window_w, window_h);
+
+    // Handle input events, with all mouse motion merged into one position
+    input_coalesce_motion(&input);
+    int window_shown = 0; // The window came back during this frame's events
+    while (have_event || SDL_PollEvent(&current_event)) {
+      have_event = 0;
+      needs_redraw = 1;
       if (current_event.type == SDL_QUIT) {
         game_running = 0;
+      }
+      if (current_event.type == SDL_WINDOWEVENT &&
+          (current_event.window.event == SDL_WINDOWEVENT_SHOWN ||
+           current_event.window.event == SDL_WINDOWEVENT_EXPOSED ||
+           current_event.window.event == SDL_WINDOWEVENT_RESTORED)) {
+        window_shown = 1;
+      }
+      // Direct3D drops render target contents on resizes, mode switches and
+      // device loss; cached targets have to be drawn (or created) again
+      if (current_event.type == SDL_RENDER_TARGETS_RESET ||
+          current_event.type == SDL_RENDER_DEVICE_RESET) {
+        int device_lost = current_event.type == SDL_RENDER_DEVICE_RESET;
+        ui_panel_reset(&menu_panel, device_lost);
+        if (device_lost) {
+          // Every texture went with the device. The glyph atlas and sprites
+          // are uploaded again from their CPU copies; the background, world
+          // target and framebuffer texture are created on their next use.
+          text_reset(graphics_renderer);
+          sprite_cache_reset(graphics_renderer);
+          render_view_reset(&view);
+          if (use_swrast)
+            swrast_reset(&swrast);
+        }
+        reset_background(&background, device_lost);
       }
         if (main_menu.is_active) {
           update_main_menu(&main_menu, &current_event, &game_running, &start_game,
@@ -244,98 +398,50 @@ int main(int argc, char *argv[]) {
           if (current_event.type == SDL_KEYDOWN ||
               current_event.type == SDL_KEYUP) {
             int key_pressed = (current_event.type == SDL_KEYDOWN);
+            input_handle_key(&input, &current_event.key);
 
             switch (current_event.key.keysym.sym) {
-            case SDLK_ESCAPE:
-              key_esc = key_pressed;
-              break;
-            case SDLK_w:
-             key_up = key_pressed;
-             break;
-           case SDLK_a:
-             key_left = key_pressed;
-             break;
-           case SDLK_s:
-             key_down = key_pressed;
-             break;
-           case SDLK_d:
-             key_right = key_pressed;
+           case SDLK_F3:
+             if (key_pressed)
+               show_debug = !show_debug;
              break;
            case SDLK_SPACE:
              if (key_pressed) {
-               // Add new enemy at random position
-               float random_x = (rand() % 700) + 50.0f;
-               float random_y = (rand() % 500) + 50.0f;
-               add_enemy_to_manager(&enemies, random_x, random_y, 1,
-                                    difficulty_level);
-               printf("New enemy added! Total enemies: %d\n",
-                      enemies.current_enemy_count);
+               // Add new enemy at random position (on the next step)
+               game_input.spawn_requests++;
              }
              break;
            }
+
+           // Movement changes are followed for the latency histogram
+           if ((input_key_bit(current_event.key.keysym.sym) &
+                ~INPUT_KEY_ESCAPE) &&
+               !current_event.key.repeat &&
+               game_input.move_count < MAX_QUEUED_MOVES) {
+             game_input.move_times[game_input.move_count++] =
+                 current_event.key.timestamp;
+           }
          }
-         if (current_event.type == SDL_MOUSEMOTION) {
-          mouse_x = current_event.motion.x;
-          mouse_y = current_event.motion.y;
-        }
         if (current_event.type == SDL_MOUSEBUTTONDOWN) {
           if (current_event.button.button == SDL_BUTTON_LEFT) {
-            // Shoot projectile
-            if (projectile_count < 30) {
-              Projectile *p = &projectiles[projectile_count++];
-              p->x = player_x + player_width / 2;
-              p->y = player_y + player_height / 2;
-              float dx = mouse_x - p->x;
-              float dy = mouse_y - p->y;
-              float dist = sqrtf(dx * dx + dy * dy);
-              if (dist > 0) {
-                p->vx = (dx / dist) * 500.0f;
-                p->vy = (dy / dist) * 500.0f;
-              } else {
-                p->vx = 500.0f;
-                p->vy = 0.0f;
-              }
-              p->alive = 1;
-              // Double shots upgrade
-              if (player_upgrades.double_shots && projectile_count < 30) {
-                Projectile *p2 = &projectiles[projectile_count++];
-                p2->x = p->x;
-                p2->y = p->y;
-                float angle = atan2f(dy, dx);
-                float offset_angle = 0.1f; // Tighter spread ~6 degrees
-                float new_angle = angle + offset_angle;
-                p2->vx = cosf(new_angle) * 500.0f;
-                p2->vy = sinf(new_angle) * 500.0f;
-                p2->alive = 1;
-              }
-              // Triple shots upgrade
-              if (player_upgrades.triple_shots && projectile_count < 30) {
-                // Shoot two additional projectiles with wider spread
-                for (int i = 0; i < 2 && projectile_count < 30; i++) {
-                  Projectile *p_extra = &projectiles[projectile_count++];
-                  p_extra->x = p->x;
-                  p_extra->y = p->y;
-                  float angle = atan2f(dy, dx);
-                  float offset_angle =
-                      (i == 0) ? -0.3f : 0.3f; // Left and right
-                  float new_angle = angle + offset_angle;
-                  p_extra->vx = cosf(new_angle) * 500.0f;
-                  p_extra->vy = sinf(new_angle) * 500.0f;
-                  p_extra->alive = 1;
-                }
-              }
+            // Queue the shot for the next simulation step, aimed where the
+            // click happened and stamped with when
+            if (game_input.shot_count < MAX_QUEUED_SHOTS) {
+              ShotCommand *shot = &game_input.shots[game_input.shot_count++];
+              render_view_to_logical(&view, current_event.button.x,
+                                     current_event.button.y, &shot->aim_x,
+                                     &shot->aim_y);
+              shot->timestamp = current_event.button.timestamp;
             }
             // Play shoot sound
-            if (shoot_sound) {
-              Mix_PlayChannel(-1, shoot_sound, 0);
-            }
+            audio_trigger(&voices, SOUND_SHOOT);
           }
         }
       }
      }
 
    // Handle escape key press
-   if (key_esc && !key_esc_prev) {
+   if (input_take_presses(&input) & INPUT_KEY_ESCAPE) {
      if (game_over_menu.is_active) {
        game_running = 0;
      } else if (main_menu.is_active) {
@@ -352,28 +458,27 @@ int main(int argc, char *argv[]) {
        is_paused = 1;
      }
    }
-   key_esc_prev = key_esc;
+
+   // Minimizing pauses the game so the loop can go idle
+   if (!window_visible && !main_menu.is_active && !upgrade_menu.is_active &&
+       !sound_menu.is_active && !game_over_menu.is_active) {
+     main_menu.is_active = 1;
+     is_paused = 1;
+   }
 
    // Check if we need to restart the game
     if (restart_game) {
-      reset_game_state(&player_x, &player_y, &player_health, &player_is_alive,
-                       &enemies, &player_score, 0);
+      sim_pipeline_wait(&sim);
+      new_game(&game);
+      sim_pipeline_publish(&sim);
+      audio_stop_effects(&voices);
+      printf("Game restarted!\n");
       // Reset key states to prevent momentum carryover
-      key_up = 0;
-      key_down = 0;
-      key_left = 0;
-      key_right = 0;
+      input_release_all(&input);
+      clear_game_input(&game_input);
       restart_game = 0;
       game_over_menu.is_active = 0; // Reset menu state
-      // Reset projectiles and difficulty
-      for (int i = 0; i < 30; i++)
-        projectiles[i].alive = 0;
-      projectile_count = 0;
-      for (int i = 0; i < 50; i++)
-        enemy_projectiles[i].alive = 0;
-      enemy_proj_count = 0;
-      total_play_time = 0.0f; // Reset difficulty on restart
-      continue;               // Skip the rest of this frame
+      continue;                     // Skip the rest of this frame
     }
 
     // Handle menu actions
@@ -387,35 +492,17 @@ int main(int argc, char *argv[]) {
         is_paused = 0;
       } else {
         // Start new game
-        player_x = 200.0f;
-        player_y = 100.0f;
-        player_health = 200.0f;
-        player_is_alive = 1;
-        player_score = 0;
+        sim_pipeline_wait(&sim);
+        new_game(&game);
+        sim_pipeline_publish(&sim);
+        audio_stop_effects(&voices);
         player_coins = load_coins();
-        cleanup_enemy_manager(&enemies);
-        initialize_enemy_manager(&enemies, 1000);
-        add_enemy_to_manager(&enemies, 400.0f, 300.0f, 1, 0);
-        add_enemy_to_manager(&enemies, 100.0f, 100.0f, 1, 0);
-        add_enemy_to_manager(&enemies, 600.0f, 400.0f, 1, 0);
-        add_enemy_to_manager(&enemies, 200.0f, 500.0f, 1, 0);
-        for (int i = 0; i < 30; i++) projectiles[i].alive = 0;
-        projectile_count = 0;
-        for (int i = 0; i < 50; i++) enemy_projectiles[i].alive = 0;
-        enemy_proj_count = 0;
-        total_play_time = 0.0f;
-        enemy_spawn_timer = 0.0f;
-        enemies_spawned_count = 0;
         main_menu.is_active = 0;
         upgrade_menu.is_active = 0;
         game_over_menu.is_active = 0;
         // Reset key states
-        key_up = 0;
-        key_down = 0;
-        key_left = 0;
-        key_right = 0;
-        key_esc = 0;
-        key_esc_prev = 0;
+        input_release_all(&input);
+        clear_game_input(&game_input);
       }
     }
      if (show_upgrades) {
@@ -432,223 +519,67 @@ int main(int argc, char *argv[]) {
       game_over_menu.is_active = 0;
     }
 
-    // Clear the screen with dynamic background color based on score (blue space
-    // theme)
-    int bg_r = 0, bg_g = 0, bg_b = 0;
-    if (player_score >= 10000) {
-      bg_b = 200; // Light blue
-    } else if (player_score >= 8000) {
-      bg_b = 150; // Medium blue
-    } else if (player_score >= 6000) {
-      bg_b = 100; // Dark blue
-    } else if (player_score >= 4000) {
-      bg_b = 50; // Very dark blue
-    } else if (player_score >= 2000) {
-      bg_b = 25; // Deep blue
-    } // else black
-    SDL_SetRenderDrawColor(graphics_renderer, bg_r, bg_g, bg_b, 255);
-    SDL_RenderClear(graphics_renderer);
-
-    // Draw stars
-    SDL_SetRenderDrawColor(graphics_renderer, 255, 255, 255, 255);
-    for (int i = 0; i < 100; i++) {
-      SDL_Rect star_rect = {star_x[i], star_y[i], 2, 2};
-      SDL_RenderFillRect(graphics_renderer, &star_rect);
+    render_batch_reset_stats(&world_batch);
+
+    int in_menu = main_menu.is_active || upgrade_menu.is_active ||
+                  sound_menu.is_active || game_over_menu.is_active;
+    if (in_menu) {
+      // Menus can change what the simulation reads (upgrades), so let the
+      // last step finish before the next frame's events are handled
+      sim_pipeline_wait(&sim);
     }
 
+    // Start this frame's sound effects. Reopening the device after
+    // underruns allocates, so it restarts the zero-allocation warmup.
+    if (audio_update(&voices, sound_menu.master_volume)) {
+      gameplay_frames = 0;
+    }
+
+    // Skip drawing entirely while the window can't be seen, and don't redraw
+    // an idle screen that hasn't changed. A hidden window must not keep the
+    // redraw request from the events it got, or the idle wait never runs;
+    // only the event that brings it back asks for a redraw.
+    if (!window_visible) {
+      needs_redraw = window_shown;
+      continue;
+    }
+    if (in_menu && !needs_redraw) {
+      continue;
+    }
+
+    // Menus cover the whole window, so the background is only drawn in game
     if (main_menu.is_active) {
-      draw_main_menu(&main_menu, graphics_renderer, window_w, window_h, is_paused);
+      draw_main_menu(&main_menu, graphics_renderer, &menu_panel, window_w,
+                     window_h, is_paused);
      } else if (upgrade_menu.is_active) {
-       draw_upgrade_menu(&upgrade_menu, graphics_renderer, window_w, window_h,
-                         player_coins, &player_upgrades);
+       draw_upgrade_menu(&upgrade_menu, graphics_renderer, &menu_panel,
+                         window_w, window_h, player_coins, &player_upgrades);
      } else if (sound_menu.is_active) {
-       draw_sound_menu(&sound_menu, graphics_renderer, window_w, window_h);
+       draw_sound_menu(&sound_menu, graphics_renderer, &menu_panel, window_w,
+                       window_h);
      } else if (game_over_menu.is_active) {
       // Draw the game over menu
-      draw_die_menu(&game_over_menu, graphics_renderer);
+      draw_die_menu(&game_over_menu, graphics_renderer, &menu_panel);
     } else {
-
-      if (player_is_alive) {
-        // NEW: Automatic enemy spawning over time (increasing difficulty)
-        enemy_spawn_timer += frame_time;
-
-        // Update difficulty based on play time (already calculated above)
-        int current_max_enemies = 15 + difficulty_level * 5;
-        float current_spawn_time = 3.0f - difficulty_level * 0.2f;
-        if (current_spawn_time < 0.3f)
-          current_spawn_time = 0.3f;
-
-        // Count how many enemies are currently alive (not dead or exploding)
-        int alive_enemies_count = 0;
-        for (int i = 0; i < enemies.current_enemy_count; i++) {
-          if (enemies.enemies_array[i].is_alive &&
-              !enemies.enemies_array[i].is_exploding) {
-            alive_enemies_count++;
-          }
-        }
-
-        // Spawn new enemy if timer reached and we're under the limit
-        if (enemy_spawn_timer >= current_spawn_time &&
-            alive_enemies_count < current_max_enemies &&
-            enemies.current_enemy_count < enemies.max_enemy_capacity) {
-
-          // Find a spawn position away from player
-          float spawn_x, spawn_y;
-          int attempts = 0;
-          int found_good_position = 0;
-
-          while (attempts < 10 && !found_good_position) {
-            // Try to spawn at edge of screen
-            int side = rand() % 4; // 0=top, 1=right, 2=bottom, 3=left
-            switch (side) {
-            case 0: // Top
-              spawn_x = (rand() % 700) + 50.0f;
-              spawn_y = 20.0f;
-              break;
-            case 1: // Right
-              spawn_x = 750.0f;
-              spawn_y = (rand() % 500) + 50.0f;
-              break;
-            case 2: // Bottom
-              spawn_x = (rand() % 700) + 50.0f;
-              spawn_y = 550.0f;
-              break;
-            case 3: // Left
-              spawn_x = 20.0f;
-              spawn_y = (rand() % 500) + 50.0f;
-              break;
-            }
-
-            // Check if spawn position is not too close to player
-            float dx = spawn_x - player_x;
-            float dy = spawn_y - player_y;
-            float distance_to_player = sqrtf(dx * dx + dy * dy);
-
-            if (distance_to_player >
-                150.0f) { // At least 150 pixels from player
-              found_good_position = 1;
-            }
-
-            attempts++;
-          }
-
-          // If no good position found, use random position
-          if (!found_good_position) {
-            spawn_x = (rand() % 700) + 50.0f;
-            spawn_y = (rand() % 500) + 50.0f;
-          }
-
-          int enemy_type =
-              (rand() % 3 == 0) ? 2 : 1; // 33% chance for purple enemy
-          // Boss spawn chance after 5 minutes
-          if (total_play_time > 300.0f && rand() % 20 == 0) {
-            enemy_type = 3; // Boss
-          }
-          // Adjust spawn position based on window size
-          if (spawn_x > window_w - 50)
-            spawn_x = window_w - 50;
-          if (spawn_y > window_h - 50)
-            spawn_y = window_h - 50;
-          add_enemy_to_manager(&enemies, spawn_x, spawn_y, enemy_type,
-                               difficulty_level);
-          enemies_spawned_count++;
-          enemy_spawn_timer = 0.0f; // Reset timer
-
-          printf(
-              "Auto-spawn: Enemy #%d spawned at (%.0f, %.0f). Alive enemies: "
-              "%d/%d (Difficulty: %d)\n",
-              enemies_spawned_count, spawn_x, spawn_y, alive_enemies_count + 1,
-              current_max_enemies, difficulty_level);
-        }
-
-        // Process player movement
-        float move_x = 0.0f, move_y = 0.0f;
-
-        if (key_up)
-          move_y -= 1.0f;
-        if (key_down)
-          move_y += 1.0f;
-        if (key_left)
-          move_x -= 1.0f;
-        if (key_right)
-          move_x += 1.0f;
-
-        // Fix diagonal movement speed
-        if (move_x != 0.0f && move_y != 0.0f) {
-          move_x *= 0.7071f;
-          move_y *= 0.7071f;
-        }
-
-        // Update player position
-        player_x += move_x * player_speed;
-        player_y += move_y * player_speed;
-
-        // Keep player within window bounds
-        if (player_x < 0)
-          player_x = 0;
-        if (player_x + player_width > window_w)
-          player_x = window_w - player_width;
-        if (player_y < 0)
-          player_y = 0;
-        if (player_y + player_height > window_h)
-          player_y = window_h - player_height;
-
-        // Update enemy positions (they chase player)
-        update_all_enemies(&enemies, player_x, player_y, frame_time, player_x,
-                           player_y, player_width, player_height);
-
-        // Check for boss death and spawn minions
-        for (int i = 0; i < enemies.current_enemy_count; i++) {
-          Enemy *e = &enemies.enemies_array[i];
-          if (e->enemy_type == 3 && !e->is_alive && !e->has_spawned_minions) {
-            // Spawn 5 fast small cube enemies
-            for (int j = 0; j < 5; j++) {
-              float minion_x = e->position_x + (rand() % 100) - 50;
-              float minion_y = e->position_y + (rand() % 100) - 50;
-              add_enemy_to_manager(&enemies, minion_x, minion_y, 4,
-                                   difficulty_level);
-            }
-            e->has_spawned_minions = 1;
-          }
-        }
-
-        // Remove dead enemies to free up array space
-        cleanup_dead_enemies(&enemies);
-
-        // Update projectiles
-        update_player_projectiles(projectiles, &projectile_count, 30, &enemies,
-                                  &player_score, window_w, window_h,
-                                  enemy_projectiles, &enemy_proj_count, 50,
-                                  frame_time, &player_upgrades, explode_sound);
-        update_enemy_projectiles(enemy_projectiles, &enemy_proj_count, 50,
-                                 player_x, player_y, player_width,
-                                 player_height, &player_health, window_w,
-                                 window_h, frame_time);
-
-        // NEW: Handle collision damage between player and enemies
-        float damage_taken = handle_player_enemy_collision_damage(
-            &enemies, player_x, player_y, player_width, player_height,
-            &player_score, explode_sound);
-        player_health -= damage_taken;
-
-        // Check for purple enemies that just died and spawn projectiles
-        for (int j = 0; j < enemies.current_enemy_count; j++) {
-          Enemy *e = &enemies.enemies_array[j];
-          if (e->is_exploding && e->enemy_type == 2 &&
-              !e->has_spawned_death_projectiles) {
-            spawn_purple_enemy_death_projectiles(e, enemy_projectiles,
-                                                 &enemy_proj_count, 50);
-          }
-
-        }
-      }
+      // Kick off this frame's simulation step; on the worker thread it runs
+      // while the newest finished snapshot is drawn below
+      game_input.frame_time = frame_time;
+      game_input.step_start = previous_input_time;
+      game_input.step_end = input_time;
+      game_input.window_w = view.logical_w;
+      game_input.window_h = view.logical_h;
+      game_input.keys = input.keys;
+      const QualitySettings *quality = governor_quality(&governor);
+      game_input.quality = *quality;
+      sim_pipeline_step(&sim, &game_input);
+      clear_game_input(&game_input);
+      const GameSnapshot *snapshot = sim_pipeline_latest(&sim);
+      presented = snapshot;
 
       // Check if player died
-      if (player_health <= 0) {
-        player_health = 0;
-        player_is_alive = 0;
+      if (!snapshot->player_is_alive) {
         // Earn coins based on score
-        int coins_earned = player_score / 10;
+        int coins_earned = snapshot->score / 10;
         player_coins += coins_earned;
         save_coins(player_coins);
         printf("Game Over! Earned %d coins. Total coins: %d\n", coins_earned,
@@ -656,70 +587,169 @@ int main(int argc, char *argv[]) {
         game_over_menu.is_active = 1;
       }
 
-      if (player_is_alive) {
-        // Draw player as red square
-        SDL_SetRenderDrawColor(graphics_renderer, 255, 0, 0, 255);
-        SDL_Rect player_rect = {player_x, player_y, player_width,
-                                 player_height};
-        SDL_RenderFillRect(graphics_renderer, &player_rect);
+      // Everything is described in the command buffer in logical
+      // coordinates. The GPU path draws the background from its cached
+      // texture instead. Gameplay goes in first so optional layers can never
+      // crowd it out.
+      render_view_set_scale(&view, options.render_scale < quality->render_scale
+                                       ? options.render_scale
+                                       : quality->render_scale);
+      starfield.active = (int)(starfield.count * quality->starfield_density);
+      render_commands_clear(&world_commands);
+
+      // Player, enemies, projectiles and score from the simulation
+      render_commands_append(&world_commands, &snapshot->commands);
+      if (use_swrast) {
+        emit_background(&background, &world_commands, view.logical_w,
+                        view.logical_h, snapshot->score);
+      }
+      if (starfield.count > 0) {
+        if (snapshot->player_is_alive)
+          update_starfield(&starfield, frame_time);
+        draw_starfield(&starfield, &world_commands, view.logical_w,
+                       view.logical_h);
+      }
+      if (world_commands.dropped > 0 && !warned_dropped) {
+        printf("Warning: %d draw commands did not fit in the frame\n",
+               world_commands.dropped);
+        warned_dropped = 1;
+      }
 
-         SDL_SetRenderDrawColor(graphics_renderer, 255, 0, 0, 255);
-         SDL_Rect player_health_bar = {10, 10, player_health, 20};
-         SDL_RenderFillRect(graphics_renderer, &player_health_bar);
+      // Cull, sort and submit the whole frame in as few calls as possible,
+      // then scale it to the window. With a native HUD the HUD and cursor
+      // layers are drawn after scaling, at window resolution.
+      if (use_swrast) {
+        int fb_w, fb_h;
+        render_view_target_size(&view, &fb_w, &fb_h);
+        swrast_render(&swrast, &world_commands, view.logical_w,
+                      view.logical_h, fb_w, fb_h, &frame_arena);
+        swrast_present(&swrast, graphics_renderer, &view.dest, view.linear);
+      } else if (options.native_hud) {
+        render_view_begin(&view, graphics_renderer);
+        draw_background(&background, graphics_renderer, &world_batch,
+                        view.target_w, view.target_h, snapshot->score);
+        render_view_use_logical(&view, graphics_renderer);
+        render_commands_submit_layers(&world_commands, &world_batch,
+                                      RENDER_LAYER_BACKGROUND,
+                                      RENDER_LAYER_PLAYER,
+                                      view.logical_w, view.logical_h,
+                                      &frame_arena);
+        render_view_end(&view, graphics_renderer);
+        render_view_begin_overlay(&view, graphics_renderer);
+        render_commands_submit_layers(&world_commands, &world_batch,
+                                      RENDER_LAYER_HUD, RENDER_LAYER_CURSOR,
+                                      view.logical_w, view.logical_h,
+                                      &frame_arena);
+        render_view_end_overlay(&view, graphics_renderer);
+      } else {
+        render_view_begin(&view, graphics_renderer);
+        draw_background(&background, graphics_renderer, &world_batch,
+                        view.target_w, view.target_h, snapshot->score);
+        render_view_use_logical(&view, graphics_renderer);
+        render_commands_submit(&world_commands, &world_batch, view.logical_w,
+                               view.logical_h, &frame_arena);
+        render_view_end(&view, graphics_renderer);
       }
 
-      // Draw score on the right side
-      int window_width, window_height;
-      SDL_GetRendererOutputSize(graphics_renderer, &window_width, &window_height);
-      SDL_Color score_color = {255, 255, 255, 255}; // White
-      char score_text[20];
-      sprintf(score_text, "SCORE: %d", player_score);
-       draw_text(graphics_renderer, score_text, window_width - 280, 10,
-                 score_color, 2.0f);
-
-      // Draw all enemies
-      draw_all_enemies(&enemies, graphics_renderer);
-
-      // Draw projectiles
-      draw_player_projectiles(projectiles, projectile_count, graphics_renderer);
-      draw_enemy_projectiles(enemy_projectiles, enemy_proj_count,
-                             graphics_renderer);
-
-      // Draw crosshair as smaller thicker circle
-      SDL_SetRenderDrawColor(graphics_renderer, 255, 255, 255, 255); // White
-      int radius = 8;
-      for (int i = 0; i < 360; i += 1) {
-        float angle1 = i * 3.14159f / 180.0f;
-        float angle2 = (i + 1) * 3.14159f / 180.0f;
-        int x1 = mouse_x + cosf(angle1) * radius;
-        int y1 = mouse_y + sinf(angle1) * radius;
-        int x2 = mouse_x + cosf(angle2) * radius;
-        int y2 = mouse_y + sinf(angle2) * radius;
-        // Draw thicker
-        SDL_RenderDrawLine(graphics_renderer, x1, y1, x2, y2);
-        SDL_RenderDrawLine(graphics_renderer, x1 + 1, y1, x2 + 1, y2);
-        SDL_RenderDrawLine(graphics_renderer, x1 - 1, y1, x2 - 1, y2);
-        SDL_RenderDrawLine(graphics_renderer, x1, y1 + 1, x2, y2 + 1);
-        SDL_RenderDrawLine(graphics_renderer, x1, y1 - 1, x2, y2 - 1);
+      if (show_debug) {
+        DebugStats stats;
+        stats.fps = smoothed_fps;
+        stats.frame_p95_ms = governor.percentile_ms;
+        stats.budget_ms = governor.budget_ms;
+        stats.quality_level = governor.level;
+        stats.quality_levels = governor_level_count();
+        stats.enemies = snapshot->enemy_count;
+        stats.motion_merged = input.motion_merged;
+        stats.commands = world_commands.count;
+        stats.culled = world_commands.culled;
+        stats.draw_calls = world_batch.draw_calls;
+        stats.pacing = frame_pacer_mode_name(pacer.mode);
+        stats.pacing_rate = pacer.rate_hz;
+        stats.pacing_error_ms = pacer.error_ms;
+        stats.pacing_worst_ms = pacer.worst_error_ms;
+        stats.latency = &latency;
+        stats.audio = &voices.stats;
+        draw_debug_overlay(graphics_renderer, &stats);
       }
+
+      // Late-latched crosshair: sample the mouse again now that the frame
+      // is built and draw it last, so it lags the hand by as little as
+      // possible. Gameplay keeps using the position from the event pump.
+      int cursor_x, cursor_y;
+      float crosshair_x, crosshair_y;
+      SDL_GetMouseState(&cursor_x, &cursor_y);
+      render_view_to_logical(&view, cursor_x, cursor_y, &crosshair_x,
+                             &crosshair_y);
+      render_view_begin_overlay(&view, graphics_renderer);
+      draw_sprite(graphics_renderer, SPRITE_CROSSHAIR, crosshair_x,
+                  crosshair_y);
+      render_view_end_overlay(&view, graphics_renderer);
+    }
+
+    // Steady-state gameplay must not touch the heap
+    int in_gameplay = !main_menu.is_active && !upgrade_menu.is_active &&
+                      !sound_menu.is_active && !game_over_menu.is_active;
+
+    // Feed the governor the time spent on this frame's work, before present
+    // can block on vsync
+    if (in_gameplay) {
+      float work_ms = (SDL_GetPerformanceCounter() - frame_start) * 1000.0f /
+                      SDL_GetPerformanceFrequency();
+      governor_record_frame(&governor, work_ms);
     }
 
     // Show everything on screen
     SDL_RenderPresent(graphics_renderer);
+    needs_redraw = in_gameplay;
+
+    // Inputs whose effect this snapshot was the first to show are now on
+    // screen
+    if (presented && presented->step != latency_step) {
+      Uint32 now = SDL_GetTicks();
+      for (int i = 0; i < presented->input_count; i++) {
+        latency_record(&latency, now - presented->input_times[i]);
+      }
+      latency_step = presented->step;
+    }
+    presented = NULL;
 
-    // Wait a bit (about 60 frames per second)
-    SDL_Delay(16);
+    if (frame_time > 0.0f) {
+      smoothed_fps = smoothed_fps * 0.9f + (1.0f / frame_time) * 0.1f;
+    }
+    gameplay_frames = in_gameplay ? gameplay_frames + 1 : 0;
+    if (gameplay_frames > ALLOC_CHECK_WARMUP_FRAMES) {
+      MEMTRACK_ASSERT_NO_FRAME_ALLOCS("gameplay");
+    }
+
+    // Hold the frame rate steady
+    frame_pacer_end_frame(&pacer);
   }
 
+  frame_pacer_report(&pacer);
+  latency_report(&latency);
+  audio_report(&voices);
+
   // Clean up memory
-  cleanup_enemy_manager(&enemies);
-  if (shoot_sound) Mix_FreeChunk(shoot_sound);
-  if (explode_sound) Mix_FreeChunk(explode_sound);
-  if (bg_music) Mix_FreeMusic(bg_music);
-  Mix_CloseAudio();
+  sim_pipeline_shutdown(&sim);
+  if (use_swrast) {
+    swrast_shutdown(&swrast);
+  }
+  cleanup_enemy_manager(&game.enemies);
+  cleanup_background(&background);
+  render_view_destroy(&view);
+  ui_panel_destroy(&menu_panel);
+  sprite_cache_shutdown();
+  text_shutdown();
+  arena_destroy(&frame_arena);
+  arena_destroy(&game_arena);
+  music_stream_close(&music_stream);
+  audio_close(&voices);
+  sound_bank_free(&sound_bank);
+  asset_pack_close(&assets);
   SDL_DestroyRenderer(graphics_renderer);
   SDL_DestroyWindow(game_window);
   SDL_Quit();
+  memtrack_report();
 
   return 0;
 }
@@ -1,14 +1,9 @@
 #include "mainMenu.h"
+#include "text.h"
 #include <SDL2/SDL.h>
 #include <stdio.h>
 #include <string.h>
 
-// Forward declarations
-void draw_text(SDL_Renderer *renderer, const char *text, float x, float y,
-               SDL_Color color, float scale);
-float get_text_width(const char *text, float scale);
-float get_text_width(const char *text, float scale);
-
 void initialize_main_menu(MainMenu *menu) {
   menu->is_active = 1;
   menu->selected_option = MENU_START_GAME;
@@ -57,7 +52,18 @@ void update_main_menu(MainMenu *menu, SDL_Event *event, int *game_running, int *
   }
 }
 
-void draw_main_menu(MainMenu *menu, SDL_Renderer *renderer, int window_w, int window_h, int is_paused) {
+void draw_main_menu(MainMenu *menu, SDL_Renderer *renderer, UiPanel *panel, int window_w, int window_h, int is_paused) {
+   // Only re-render when the selection, pause state or window size changed
+   unsigned long key = ui_hash_int(UI_HASH_SEED, 1);
+   key = ui_hash_int(key, menu->selected_option);
+   key = ui_hash_int(key, is_paused);
+   key = ui_hash_int(key, window_w);
+   key = ui_hash_int(key, window_h);
+   if (!ui_panel_begin(panel, renderer, window_w, window_h, key)) {
+     ui_panel_draw(panel, renderer);
+     return;
+   }
+
    // Clear screen
    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
    SDL_RenderClear(renderer);
@@ -82,4 +88,7 @@ void draw_main_menu(MainMenu *menu, SDL_Renderer *renderer, int window_w, int wi
     const char *instr = "USE UP/DOWN TO SELECT, ENTER TO CONFIRM";
     float instr_width = get_text_width(instr, 1.0f);
     draw_text(renderer, instr, window_w / 2 - instr_width / 2, window_h - 50, instr_color, 1.0f);
+
+    ui_panel_end(panel, renderer);
+    ui_panel_draw(panel, renderer);
 }
\ No newline at end of file
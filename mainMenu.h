@@ -1,6 +1,7 @@
 #ifndef MAINMENU_H
 #define MAINMENU_H
 
+#include "uiCache.h"
 #include <SDL2/SDL.h>
 
 typedef enum {
@@ -20,6 +21,6 @@ typedef struct {
 // Function declarations
 void initialize_main_menu(MainMenu *menu);
 void update_main_menu(MainMenu *menu, SDL_Event *event, int *game_running, int *start_game, int *show_upgrades, int *show_sound);
-void draw_main_menu(MainMenu *menu, SDL_Renderer *renderer, int window_w, int window_h, int is_paused);
+void draw_main_menu(MainMenu *menu, SDL_Renderer *renderer, UiPanel *panel, int window_w, int window_h, int is_paused);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,200 @@
+#include "memtrack.h"
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef VV_TRACK_ALLOCATIONS
+
+// Every tracked block carries a small header in front of the user pointer so
+// free/realloc know how many bytes to take off the books. 16 bytes keeps the
+// returned pointer as aligned as malloc's.
+#define MEM_HEADER_SIZE 16
+
+typedef struct {
+  size_t size;
+  int subsystem;
+} MemHeader;
+
+static MemStats stats;
+static SDL_SpinLock stats_lock;
+
+static void record_alloc(size_t size, int subsystem) {
+  SDL_AtomicLock(&stats_lock);
+  stats.total[subsystem].allocations++;
+  stats.total[subsystem].bytes += size;
+  stats.frame[subsystem].allocations++;
+  stats.frame[subsystem].bytes += size;
+  stats.live_bytes += size;
+  if (stats.live_bytes > stats.peak_bytes)
+    stats.peak_bytes = stats.live_bytes;
+  SDL_AtomicUnlock(&stats_lock);
+}
+
+static void record_free(size_t size) {
+  SDL_AtomicLock(&stats_lock);
+  stats.live_bytes -= size;
+  SDL_AtomicUnlock(&stats_lock);
+}
+
+static void *tracked_alloc(size_t size, int subsystem) {
+  unsigned char *block = malloc(size + MEM_HEADER_SIZE);
+  if (!block)
+    return NULL;
+  MemHeader *header = (MemHeader *)block;
+  header->size = size;
+  header->subsystem = subsystem;
+  record_alloc(size, subsystem);
+  return block + MEM_HEADER_SIZE;
+}
+
+static void tracked_free(void *memory) {
+  if (!memory)
+    return;
+  unsigned char *block = (unsigned char *)memory - MEM_HEADER_SIZE;
+  record_free(((MemHeader *)block)->size);
+  free(block);
+}
+
+static void *sdl_malloc_hook(size_t size) { return tracked_alloc(size, MEM_SDL); }
+
+static void *sdl_calloc_hook(size_t count, size_t size) {
+  void *memory = tracked_alloc(count * size, MEM_SDL);
+  if (memory)
+    memset(memory, 0, count * size);
+  return memory;
+}
+
+static void *sdl_realloc_hook(void *memory, size_t size) {
+  if (!memory)
+    return tracked_alloc(size, MEM_SDL);
+  unsigned char *block = (unsigned char *)memory - MEM_HEADER_SIZE;
+  size_t old_size = ((MemHeader *)block)->size;
+  unsigned char *grown = realloc(block, size + MEM_HEADER_SIZE);
+  if (!grown)
+    return NULL;
+  ((MemHeader *)grown)->size = size;
+  record_free(old_size);
+  record_alloc(size, MEM_SDL);
+  return grown + MEM_HEADER_SIZE;
+}
+
+void *mem_alloc(size_t size, MemSubsystem subsystem) {
+  return tracked_alloc(size, subsystem);
+}
+
+void mem_free(void *memory) { tracked_free(memory); }
+
+void memtrack_install_sdl_hooks(void) {
+  if (SDL_SetMemoryFunctions(sdl_malloc_hook, sdl_calloc_hook,
+                             sdl_realloc_hook, tracked_free) < 0) {
+    printf("Warning: Could not hook SDL allocations: %s\n", SDL_GetError());
+  }
+}
+
+void memtrack_begin_frame(void) {
+  SDL_AtomicLock(&stats_lock);
+  memset(stats.frame, 0, sizeof(stats.frame));
+  SDL_AtomicUnlock(&stats_lock);
+}
+
+unsigned long memtrack_frame_allocations(void) {
+  unsigned long count = 0;
+  SDL_AtomicLock(&stats_lock);
+  for (int i = 0; i < MEM_SUBSYSTEM_COUNT; i++)
+    count += stats.frame[i].allocations;
+  SDL_AtomicUnlock(&stats_lock);
+  return count;
+}
+
+void memtrack_get_stats(MemStats *out) {
+  SDL_AtomicLock(&stats_lock);
+  *out = stats;
+  SDL_AtomicUnlock(&stats_lock);
+}
+
+void memtrack_note_texture(int width, int height, int bytes_per_pixel) {
+  SDL_AtomicLock(&stats_lock);
+  stats.texture_bytes += (size_t)width * height * bytes_per_pixel;
+  SDL_AtomicUnlock(&stats_lock);
+}
+
+void memtrack_forget_texture(int width, int height, int bytes_per_pixel) {
+  SDL_AtomicLock(&stats_lock);
+  stats.texture_bytes -= (size_t)width * height * bytes_per_pixel;
+  SDL_AtomicUnlock(&stats_lock);
+}
+
+void memtrack_note_audio(size_t bytes) {
+  SDL_AtomicLock(&stats_lock);
+  stats.audio_bytes += bytes;
+  SDL_AtomicUnlock(&stats_lock);
+}
+
+void memtrack_forget_audio(size_t bytes) {
+  SDL_AtomicLock(&stats_lock);
+  stats.audio_bytes -= bytes;
+  SDL_AtomicUnlock(&stats_lock);
+}
+
+void memtrack_assert_no_frame_allocations(const char *where) {
+  unsigned long count = memtrack_frame_allocations();
+  if (count > 0) {
+    MemStats snapshot;
+    memtrack_get_stats(&snapshot);
+    printf("Error: %lu heap allocations during %s frame (game %lu, render "
+           "%lu, audio %lu, SDL %lu)\n",
+           count, where, snapshot.frame[MEM_GAME].allocations,
+           snapshot.frame[MEM_RENDER].allocations,
+           snapshot.frame[MEM_AUDIO].allocations,
+           snapshot.frame[MEM_SDL].allocations);
+  }
+  SDL_assert(count == 0);
+}
+
+void memtrack_report(void) {
+  static const char *names[MEM_SUBSYSTEM_COUNT] = {"game", "render", "audio",
+                                                   "SDL"};
+  MemStats snapshot;
+  memtrack_get_stats(&snapshot);
+  printf("Memory report:\n");
+  for (int i = 0; i < MEM_SUBSYSTEM_COUNT; i++) {
+    printf("  %-6s %8lu allocations, %10lu bytes\n", names[i],
+           snapshot.total[i].allocations, snapshot.total[i].bytes);
+  }
+  printf("  live %lu bytes, peak %lu bytes\n",
+         (unsigned long)snapshot.live_bytes,
+         (unsigned long)snapshot.peak_bytes);
+  printf("  textures %lu bytes, audio %lu bytes\n",
+         (unsigned long)snapshot.texture_bytes,
+         (unsigned long)snapshot.audio_bytes);
+}
+
+#else
+
+void *mem_alloc(size_t size, MemSubsystem subsystem) {
+  (void)subsystem;
+  return malloc(size);
+}
+
+void mem_free(void *memory) { free(memory); }
+
+void memtrack_install_sdl_hooks(void) {}
+void memtrack_begin_frame(void) {}
+unsigned long memtrack_frame_allocations(void) { return 0; }
+void memtrack_get_stats(MemStats *out) { memset(out, 0, sizeof(*out)); }
+void memtrack_note_texture(int width, int height, int bytes_per_pixel) {
+  (void)width;
+  (void)height;
+  (void)bytes_per_pixel;
+}
+void memtrack_forget_texture(int width, int height, int bytes_per_pixel) {
+  (void)width;
+  (void)height;
+  (void)bytes_per_pixel;
+}
+void memtrack_note_audio(size_t bytes) { (void)bytes; }
+void memtrack_forget_audio(size_t bytes) { (void)bytes; }
+void memtrack_report(void) {}
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef MEMTRACK_H
+#define MEMTRACK_H
+
+#include <stddef.h>
+
+// Optional allocation tracking. Build with -DVV_TRACK_ALLOCATIONS (see the
+// "debug" make target) to count allocations per frame and per subsystem;
+// without it mem_alloc/mem_free are plain malloc/free and the rest are no-ops.
+
+typedef enum {
+  MEM_GAME,   // Arenas and other game-owned blocks
+  MEM_RENDER, // Game-owned render buffers
+  MEM_AUDIO,  // Game-owned audio buffers
+  MEM_SDL,    // Anything SDL or SDL_mixer allocates
+  MEM_SUBSYSTEM_COUNT
+} MemSubsystem;
+
+typedef struct {
+  unsigned long allocations; // Number of malloc/calloc/realloc calls
+  unsigned long bytes;       // Bytes requested by those calls
+} MemCounter;
+
+typedef struct {
+  MemCounter total[MEM_SUBSYSTEM_COUNT];
+  MemCounter frame[MEM_SUBSYSTEM_COUNT];
+  size_t live_bytes;
+  size_t peak_bytes;
+  size_t texture_bytes;
+  size_t audio_bytes;
+} MemStats;
+
+// Function declarations
+void *mem_alloc(size_t size, MemSubsystem subsystem);
+void mem_free(void *memory);
+void memtrack_install_sdl_hooks(void); // Must run before SDL_Init
+void memtrack_begin_frame(void);
+unsigned long memtrack_frame_allocations(void);
+void memtrack_get_stats(MemStats *stats);
+void memtrack_note_texture(int width, int height, int bytes_per_pixel);
+void memtrack_forget_texture(int width, int height, int bytes_per_pixel);
+void memtrack_note_audio(size_t bytes);
+void memtrack_forget_audio(size_t bytes);
+void memtrack_report(void);
+
+// Fails (in tracking builds) if the current frame allocated anything
+#ifdef VV_TRACK_ALLOCATIONS
+void memtrack_assert_no_frame_allocations(const char *where);
+#define MEMTRACK_ASSERT_NO_FRAME_ALLOCS(where)                                \
+  memtrack_assert_no_frame_allocations(where)
+#else
+#define MEMTRACK_ASSERT_NO_FRAME_ALLOCS(where) ((void)0)
+#endif
+
+#endif
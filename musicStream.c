@@ -0,0 +1,256 @@
+#include "musicStream.h"
+#include "memtrack.h"
+#include <stdio.h>
+#include <string.h>
+
+// Largest single read from the file
+#define READ_CHUNK (16 * 1024)
+
+// Bytes kept behind the decoder for short backward seeks
+#define KEEP_BEHIND (4 * 1024)
+
+static int reader_main(void *data) {
+  MusicStream *stream = data;
+  SDL_LockMutex(stream->lock);
+  while (!stream->quit) {
+    Sint64 fill = stream->window_start + stream->buffered;
+    if (stream->buffered == MUSIC_READ_AHEAD || fill >= stream->size) {
+      SDL_CondWait(stream->space, stream->lock);
+      continue;
+    }
+    int tail = (stream->ring_head + stream->buffered) % MUSIC_READ_AHEAD;
+    int count = MUSIC_READ_AHEAD - stream->buffered;
+    if (count > MUSIC_READ_AHEAD - tail)
+      count = MUSIC_READ_AHEAD - tail;
+    if (count > READ_CHUNK)
+      count = READ_CHUNK;
+    if (count > stream->size - fill)
+      count = (int)(stream->size - fill);
+    Uint32 generation = stream->generation;
+    SDL_UnlockMutex(stream->lock);
+
+    // The decoder never reads past the buffered bytes, so this part of the
+    // ring is the reader's until it is published below
+    size_t got = 0;
+    if (stream->source_position == fill ||
+        SDL_RWseek(stream->source, fill, RW_SEEK_SET) == fill) {
+      got = SDL_RWread(stream->source, stream->ring + tail, 1, count);
+    }
+    stream->source_position = fill + (Sint64)got;
+
+    SDL_LockMutex(stream->lock);
+    if (generation != stream->generation)
+      continue; // The decoder jumped elsewhere meanwhile
+    if (got == 0) {
+      // Treat a failed read as the end of the track rather than spin on it
+      printf("Warning: Music stream could not read at %ld\n", (long)fill);
+      stream->size = fill;
+    }
+    stream->buffered += (int)got;
+    SDL_CondSignal(stream->filled);
+  }
+  SDL_UnlockMutex(stream->lock);
+  return 0;
+}
+
+// Restart the read-ahead at position. Lock held.
+static void move_window(MusicStream *stream, Sint64 position) {
+  stream->window_start = position;
+  stream->ring_head = 0;
+  stream->buffered = 0;
+  stream->generation++;
+  SDL_CondSignal(stream->space);
+}
+
+// Give the reader back ring space the decoder has moved past. Lock held.
+static void release_consumed(MusicStream *stream) {
+  Sint64 behind = stream->position - stream->window_start;
+  if (behind <= KEEP_BEHIND || behind > stream->buffered)
+    return;
+  int drop = (int)(behind - KEEP_BEHIND);
+  stream->ring_head = (stream->ring_head + drop) % MUSIC_READ_AHEAD;
+  stream->buffered -= drop;
+  stream->window_start += drop;
+  SDL_CondSignal(stream->space);
+}
+
+static size_t SDLCALL stream_read(SDL_RWops *rw, void *ptr, size_t size,
+                                  size_t maxnum) {
+  MusicStream *stream = rw->hidden.unknown.data1;
+  Uint8 *out = ptr;
+  size_t wanted = size * maxnum, copied = 0;
+  if (wanted == 0)
+    return 0;
+
+  SDL_LockMutex(stream->lock);
+  while (copied < wanted && stream->position < stream->size) {
+    Sint64 position = stream->position;
+    size_t count = wanted - copied;
+
+    if (position < stream->prefix_bytes) {
+      // Back at the start, most likely looping: have the reader line up
+      // what follows the prefix while the prefix plays
+      if (stream->window_start != stream->prefix_bytes)
+        move_window(stream, stream->prefix_bytes);
+      if (count > (size_t)(stream->prefix_bytes - position))
+        count = (size_t)(stream->prefix_bytes - position);
+      memcpy(out + copied, stream->prefix + position, count);
+    } else {
+      Sint64 end = stream->window_start + stream->buffered;
+      if (position < stream->window_start || position > end) {
+        move_window(stream, position);
+        continue;
+      }
+      if (position == end) {
+        stream->stalls++;
+        release_consumed(stream);
+        SDL_CondWait(stream->filled, stream->lock);
+        continue;
+      }
+      int index = (stream->ring_head + (int)(position - stream->window_start)) %
+                  MUSIC_READ_AHEAD;
+      if (count > (size_t)(end - position))
+        count = (size_t)(end - position);
+      if (count > (size_t)(MUSIC_READ_AHEAD - index))
+        count = (size_t)(MUSIC_READ_AHEAD - index);
+      memcpy(out + copied, stream->ring + index, count);
+    }
+    copied += count;
+    stream->position += (Sint64)count;
+  }
+  release_consumed(stream);
+  SDL_UnlockMutex(stream->lock);
+  return copied / size;
+}
+
+static Sint64 SDLCALL stream_seek(SDL_RWops *rw, Sint64 offset, int whence) {
+  MusicStream *stream = rw->hidden.unknown.data1;
+  SDL_LockMutex(stream->lock);
+  Sint64 target = offset;
+  if (whence == RW_SEEK_CUR) {
+    target += stream->position;
+  } else if (whence == RW_SEEK_END) {
+    target += stream->size;
+  }
+  if (target < 0 || target > stream->size) {
+    target = -1;
+  } else {
+    stream->position = target;
+  }
+  SDL_UnlockMutex(stream->lock);
+  return target;
+}
+
+static Sint64 SDLCALL stream_size(SDL_RWops *rw) {
+  MusicStream *stream = rw->hidden.unknown.data1;
+  SDL_LockMutex(stream->lock);
+  Sint64 size = stream->size;
+  SDL_UnlockMutex(stream->lock);
+  return size;
+}
+
+static size_t SDLCALL stream_write(SDL_RWops *rw, const void *ptr,
+                                   size_t size, size_t num) {
+  (void)rw;
+  (void)ptr;
+  (void)size;
+  (void)num;
+  return 0;
+}
+
+// SDL_mixer doesn't own the stream; music_stream_close frees it
+static int SDLCALL stream_close(SDL_RWops *rw) {
+  (void)rw;
+  return 0;
+}
+
+// Start streaming music from source, which the stream takes over. SDL_mixer
+// tells the format apart by its header, so an OGG or a WAV both work.
+// Returns NULL (with a warning) when it can't be played.
+Mix_Music *music_stream_open(MusicStream *stream, SDL_RWops *source) {
+  memset(stream, 0, sizeof(*stream));
+  if (!source)
+    return NULL;
+  stream->source = source;
+  stream->size = SDL_RWsize(source);
+  if (stream->size <= 0) {
+    printf("Warning: Music stream is empty\n");
+    music_stream_close(stream);
+    return NULL;
+  }
+
+  stream->prefix_bytes =
+      stream->size < MUSIC_PREFIX ? (int)stream->size : MUSIC_PREFIX;
+  stream->prefix = mem_alloc(stream->prefix_bytes, MEM_AUDIO);
+  stream->ring = mem_alloc(MUSIC_READ_AHEAD, MEM_AUDIO);
+  stream->lock = SDL_CreateMutex();
+  stream->filled = SDL_CreateCond();
+  stream->space = SDL_CreateCond();
+  stream->rw = SDL_AllocRW();
+  if (!stream->prefix || !stream->ring || !stream->lock || !stream->filled ||
+      !stream->space || !stream->rw ||
+      SDL_RWread(source, stream->prefix, stream->prefix_bytes, 1) != 1) {
+    printf("Warning: Could not set up the music stream\n");
+    music_stream_close(stream);
+    return NULL;
+  }
+  stream->source_position = stream->prefix_bytes;
+  stream->window_start = stream->prefix_bytes;
+
+  stream->rw->size = stream_size;
+  stream->rw->seek = stream_seek;
+  stream->rw->read = stream_read;
+  stream->rw->write = stream_write;
+  stream->rw->close = stream_close;
+  stream->rw->type = SDL_RWOPS_UNKNOWN;
+  stream->rw->hidden.unknown.data1 = stream;
+
+  stream->thread = SDL_CreateThread(reader_main, "music reader", stream);
+  if (!stream->thread) {
+    printf("Warning: Could not start the music reader: %s\n", SDL_GetError());
+    music_stream_close(stream);
+    return NULL;
+  }
+
+  stream->music = Mix_LoadMUS_RW(stream->rw, 0);
+  if (!stream->music) {
+    printf("Warning: Could not decode music: %s\n", Mix_GetError());
+    music_stream_close(stream);
+    return NULL;
+  }
+  // Opening seeks around the file; only count waits while playing
+  SDL_LockMutex(stream->lock);
+  stream->stalls = 0;
+  SDL_UnlockMutex(stream->lock);
+  return stream->music;
+}
+
+void music_stream_close(MusicStream *stream) {
+  if (stream->music) {
+    Mix_FreeMusic(stream->music);
+    stream->music = NULL;
+  }
+  if (stream->thread) {
+    SDL_LockMutex(stream->lock);
+    stream->quit = 1;
+    SDL_CondSignal(stream->space);
+    SDL_UnlockMutex(stream->lock);
+    SDL_WaitThread(stream->thread, NULL);
+    stream->thread = NULL;
+    if (stream->stalls > 0)
+      printf("Music: %u reads waited on the disk\n", stream->stalls);
+  }
+  if (stream->rw)
+    SDL_FreeRW(stream->rw);
+  if (stream->source)
+    SDL_RWclose(stream->source);
+  if (stream->filled)
+    SDL_DestroyCond(stream->filled);
+  if (stream->space)
+    SDL_DestroyCond(stream->space);
+  if (stream->lock)
+    SDL_DestroyMutex(stream->lock);
+  mem_free(stream->prefix);
+  mem_free(stream->ring);
+  memset(stream, 0, sizeof(*stream));
+}
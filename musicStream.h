@@ -0,0 +1,47 @@
+#ifndef MUSICSTREAM_H
+#define MUSICSTREAM_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+
+// Bytes read ahead of the decoder, and bytes of the file start kept for
+// good so looping back to the beginning never waits on the disk
+#define MUSIC_READ_AHEAD (64 * 1024)
+#define MUSIC_PREFIX (16 * 1024)
+
+// Compressed music fed to SDL_mixer's decoder from memory. A reader thread
+// keeps a small ring of the bytes after the decoder's position filled, so
+// the decoder, which runs on the audio thread, only copies bytes out and
+// never touches the file itself. Only the ring and the file start are
+// resident, not the decoded track.
+typedef struct {
+  SDL_RWops *source; // The compressed file, reader thread only
+  Sint64 source_position;
+  Sint64 size;
+
+  Uint8 *prefix; // First prefix_bytes of the file
+  int prefix_bytes;
+
+  Uint8 *ring; // Bytes [window_start, window_start + buffered)
+  int ring_head; // Ring index of window_start
+  int buffered;
+  Sint64 window_start;
+  Sint64 position;   // Where the decoder reads next
+  Uint32 generation; // Bumped when the window jumps, so stale reads are dropped
+
+  SDL_mutex *lock;
+  SDL_cond *filled; // Reader thread to decoder
+  SDL_cond *space;  // Decoder to reader thread
+  SDL_Thread *thread;
+  int quit;
+  Uint32 stalls; // Reads that had to wait for the disk
+
+  SDL_RWops *rw; // What SDL_mixer reads
+  Mix_Music *music;
+} MusicStream;
+
+// Function declarations
+Mix_Music *music_stream_open(MusicStream *stream, SDL_RWops *source);
+void music_stream_close(MusicStream *stream);
+
+#endif
@@ -0,0 +1,131 @@
+#include "options.h"
+#include "audio.h"
+#include "background.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void print_usage(const char *program) {
+  printf("Usage: %s [options]\n", program);
+  printf("  --starfield          Enable the parallax starfield\n");
+  printf("  --stars N            Parallax stars, up to 20000 (default 3000)\n");
+  printf("  --single-thread      Run the simulation on the main thread\n");
+  printf("  --resolution WxH     Internal world resolution (default: window)\n");
+  printf("  --render-scale F     World render scale, 0.25 to 1 (default 1)\n");
+  printf("  --filter MODE        Upscaling filter: linear or nearest\n");
+  printf("  --native-hud         Draw the HUD at window resolution\n");
+  printf("  --frame-budget MS    Frame time the quality governor aims for\n");
+  printf("  --no-governor        Always render at full quality\n");
+  printf("  --software           Use the built-in software rasterizer\n");
+  printf("  --raster-threads N   Software rasterizer threads (default: CPUs)\n");
+  printf("  --pacing MODE        Frame pacing: vsync, fps or uncapped\n");
+  printf("  --fps N              Frame rate for fps pacing (default: display)\n");
+  printf("  --audio-rate HZ      Audio sample rate (default 44100)\n");
+  printf("  --audio-buffer N     Audio buffer in sample frames (default 2048)\n");
+  printf("  --low-latency-audio  Small audio buffer (256 frames)\n");
+  printf("  --software-mix       Mix sound effects with the built-in mixer\n");
+}
+
+void parse_game_options(GameOptions *options, int argc, char *argv[]) {
+  // Defaults
+  options->starfield = 0;
+  options->starfield_stars = 3000;
+  options->sim_thread = 1;
+  options->logical_w = 0;
+  options->logical_h = 0;
+  options->render_scale = 1.0f;
+  options->linear_filter = 1;
+  options->native_hud = 0;
+  options->governor = 1;
+  options->frame_budget_ms = 16.6f;
+  options->software_renderer = 0;
+  options->raster_threads = 0;
+  options->pacing = PACE_VSYNC;
+  options->target_fps = 0.0f;
+  options->audio_rate = 44100;
+  options->audio_buffer = AUDIO_DEFAULT_BUFFER;
+  options->software_mix = 0;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--starfield") == 0) {
+      options->starfield = 1;
+    } else if (strcmp(argv[i], "--stars") == 0 && i + 1 < argc) {
+      options->starfield_stars = atoi(argv[++i]);
+      if (options->starfield_stars < 0)
+        options->starfield_stars = 0;
+      if (options->starfield_stars > STARFIELD_MAX_STARS)
+        options->starfield_stars = STARFIELD_MAX_STARS;
+    } else if (strcmp(argv[i], "--single-thread") == 0) {
+      options->sim_thread = 0;
+    } else if (strcmp(argv[i], "--resolution") == 0 && i + 1 < argc) {
+      i++;
+      if (sscanf(argv[i], "%dx%d", &options->logical_w,
+                 &options->logical_h) != 2 ||
+          options->logical_w < 64 || options->logical_h < 64) {
+        printf("Warning: Ignoring bad resolution %s\n", argv[i]);
+        options->logical_w = 0;
+        options->logical_h = 0;
+      }
+    } else if (strcmp(argv[i], "--render-scale") == 0 && i + 1 < argc) {
+      options->render_scale = (float)atof(argv[++i]);
+      if (options->render_scale < 0.25f)
+        options->render_scale = 0.25f;
+      if (options->render_scale > 1.0f)
+        options->render_scale = 1.0f;
+    } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+      options->linear_filter = strcmp(argv[++i], "nearest") != 0;
+    } else if (strcmp(argv[i], "--native-hud") == 0) {
+      options->native_hud = 1;
+    } else if (strcmp(argv[i], "--frame-budget") == 0 && i + 1 < argc) {
+      options->frame_budget_ms = (float)atof(argv[++i]);
+      if (options->frame_budget_ms < 1.0f)
+        options->frame_budget_ms = 1.0f;
+    } else if (strcmp(argv[i], "--no-governor") == 0) {
+      options->governor = 0;
+    } else if (strcmp(argv[i], "--software") == 0) {
+      options->software_renderer = 1;
+    } else if (strcmp(argv[i], "--raster-threads") == 0 && i + 1 < argc) {
+      options->raster_threads = atoi(argv[++i]);
+      if (options->raster_threads < 0)
+        options->raster_threads = 0;
+    } else if (strcmp(argv[i], "--pacing") == 0 && i + 1 < argc) {
+      i++;
+      if (strcmp(argv[i], "vsync") == 0) {
+        options->pacing = PACE_VSYNC;
+      } else if (strcmp(argv[i], "fps") == 0) {
+        options->pacing = PACE_TARGET_FPS;
+      } else if (strcmp(argv[i], "uncapped") == 0) {
+        options->pacing = PACE_UNCAPPED;
+      } else {
+        printf("Warning: Ignoring unknown pacing mode %s\n", argv[i]);
+      }
+    } else if (strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+      options->pacing = PACE_TARGET_FPS;
+      options->target_fps = (float)atof(argv[++i]);
+      if (options->target_fps < 10.0f)
+        options->target_fps = 10.0f;
+    } else if (strcmp(argv[i], "--audio-rate") == 0 && i + 1 < argc) {
+      options->audio_rate = atoi(argv[++i]);
+      if (options->audio_rate < 8000 || options->audio_rate > 192000) {
+        printf("Warning: Ignoring bad audio rate %d\n", options->audio_rate);
+        options->audio_rate = 44100;
+      }
+    } else if (strcmp(argv[i], "--audio-buffer") == 0 && i + 1 < argc) {
+      // SDL wants a power of two
+      int frames = atoi(argv[++i]);
+      options->audio_buffer = 64;
+      while (options->audio_buffer < frames &&
+             options->audio_buffer < AUDIO_MAX_BUFFER)
+        options->audio_buffer *= 2;
+    } else if (strcmp(argv[i], "--low-latency-audio") == 0) {
+      options->audio_buffer = AUDIO_LOW_LATENCY_BUFFER;
+    } else if (strcmp(argv[i], "--software-mix") == 0) {
+      options->software_mix = 1;
+    } else if (strcmp(argv[i], "--help") == 0) {
+      print_usage(argv[0]);
+      exit(0);
+    } else {
+      printf("Warning: Ignoring unknown option %s\n", argv[i]);
+    }
+  }
+}
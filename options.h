@@ -0,0 +1,30 @@
+#ifndef OPTIONS_H
+#define OPTIONS_H
+
+#include "framePacer.h"
+
+// Startup options parsed from the command line
+typedef struct {
+  int starfield;       // Draw the parallax starfield over the background
+  int starfield_stars; // Number of parallax stars
+  int sim_thread;      // Run the simulation on its own thread
+  int logical_w;       // Internal world resolution, 0 = follow the window
+  int logical_h;
+  float render_scale;  // World render target size relative to logical size
+  int linear_filter;   // Filtering when scaling the world to the window
+  int native_hud;      // Draw the HUD at window resolution
+  int governor;        // Lower quality automatically when over budget
+  float frame_budget_ms;
+  int software_renderer; // Rasterize the world on the CPU
+  int raster_threads;    // Software rasterizer threads, 0 = one per CPU
+  PaceMode pacing;       // How the end of each frame is timed
+  float target_fps;      // Rate for target pacing, 0 = display refresh
+  int audio_rate;        // Requested sample rate
+  int audio_buffer;      // Requested device buffer, sample frames
+  int software_mix;      // Mix sound effects with the game's own mixer
+} GameOptions;
+
+// Function declarations
+void parse_game_options(GameOptions *options, int argc, char *argv[]);
+
+#endif
@@ -0,0 +1,137 @@
+#include "particles.h"
+#include <math.h>
+#include <stdlib.h>
+
+// Debris flies out far enough to clear the flash, like the old four dots
+#define PARTICLE_LIFETIME 0.3f
+#define PARTICLE_SPEED_MIN 60.0f
+#define PARTICLE_SPEED_RANGE 80.0f
+#define PARTICLE_SIZE 4.0f
+
+int initialize_particles(ParticleSystem *particles, Arena *arena) {
+  particles->effect_x = arena_alloc(arena, sizeof(float) * MAX_EFFECTS);
+  particles->effect_y = arena_alloc(arena, sizeof(float) * MAX_EFFECTS);
+  particles->effect_size = arena_alloc(arena, sizeof(float) * MAX_EFFECTS);
+  particles->effect_time = arena_alloc(arena, sizeof(float) * MAX_EFFECTS);
+  particles->effect_kind = arena_alloc(arena, sizeof(Uint8) * MAX_EFFECTS);
+  particles->x = arena_alloc(arena, sizeof(float) * MAX_PARTICLES);
+  particles->y = arena_alloc(arena, sizeof(float) * MAX_PARTICLES);
+  particles->vx = arena_alloc(arena, sizeof(float) * MAX_PARTICLES);
+  particles->vy = arena_alloc(arena, sizeof(float) * MAX_PARTICLES);
+  particles->life = arena_alloc(arena, sizeof(float) * MAX_PARTICLES);
+  reset_particles(particles);
+  return particles->effect_x && particles->effect_y &&
+         particles->effect_size && particles->effect_time &&
+         particles->effect_kind && particles->x && particles->y &&
+         particles->vx && particles->vy && particles->life;
+}
+
+void reset_particles(ParticleSystem *particles) {
+  particles->effect_count = 0;
+  particles->count = 0;
+}
+
+void spawn_explosion(ParticleSystem *particles, float center_x,
+                     float center_y, float size, int enemy_type,
+                     int particle_count) {
+  if (particles->effect_count < MAX_EFFECTS) {
+    int e = particles->effect_count++;
+    particles->effect_x[e] = center_x;
+    particles->effect_y[e] = center_y;
+    particles->effect_size[e] = size;
+    particles->effect_time[e] = EXPLOSION_TIME;
+    particles->effect_kind[e] = (Uint8)enemy_type;
+  }
+
+  // Evenly spread directions with a random twist and speed
+  float twist = (rand() % 628) / 100.0f;
+  for (int i = 0; i < particle_count && particles->count < MAX_PARTICLES;
+       i++) {
+    int p = particles->count++;
+    float angle = twist + i * 6.2832f / particle_count;
+    float speed = PARTICLE_SPEED_MIN + (rand() % 100) * PARTICLE_SPEED_RANGE /
+                                           100.0f;
+    particles->x[p] = center_x;
+    particles->y[p] = center_y;
+    particles->vx[p] = cosf(angle) * speed;
+    particles->vy[p] = sinf(angle) * speed;
+    particles->life[p] = PARTICLE_LIFETIME;
+  }
+}
+
+void update_particles(ParticleSystem *particles, float frame_time) {
+  // Integrate everything in one branch-free pass the compiler can vectorize
+  float *restrict x = particles->x;
+  float *restrict y = particles->y;
+  float *restrict vx = particles->vx;
+  float *restrict vy = particles->vy;
+  float *restrict life = particles->life;
+  int count = particles->count;
+  for (int i = 0; i < count; i++) {
+    x[i] += vx[i] * frame_time;
+    y[i] += vy[i] * frame_time;
+    life[i] -= frame_time;
+  }
+
+  // Then drop the expired ones by moving the last live entry into the hole
+  for (int i = 0; i < count;) {
+    if (life[i] > 0.0f) {
+      i++;
+      continue;
+    }
+    count--;
+    x[i] = x[count];
+    y[i] = y[count];
+    vx[i] = vx[count];
+    vy[i] = vy[count];
+    life[i] = life[count];
+  }
+  particles->count = count;
+
+  for (int e = 0; e < particles->effect_count;) {
+    particles->effect_time[e] -= frame_time;
+    if (particles->effect_time[e] > 0.0f) {
+      e++;
+      continue;
+    }
+    int last = --particles->effect_count;
+    particles->effect_x[e] = particles->effect_x[last];
+    particles->effect_y[e] = particles->effect_y[last];
+    particles->effect_size[e] = particles->effect_size[last];
+    particles->effect_time[e] = particles->effect_time[last];
+    particles->effect_kind[e] = particles->effect_kind[last];
+  }
+}
+
+void draw_particles(ParticleSystem *particles, RenderCommandBuffer *commands) {
+  for (int e = 0; e < particles->effect_count; e++) {
+    // Explosion effect - changing colors and growing size
+    float progress = 1.0f - (particles->effect_time[e] / EXPLOSION_TIME);
+    int red = 255;
+    int green = (int)(255 * progress);
+    int blue = 0;
+
+    // For purple enemies, make explosion purple
+    if (particles->effect_kind[e] == 2) {
+      red = 128;
+      blue = 128;
+    } else if (particles->effect_kind[e] == 3) { // Boss explosion
+      green = (int)(128 * progress);
+    }
+
+    float size = particles->effect_size[e] + 20.0f * progress;
+    emit_quad(commands, RENDER_LAYER_EFFECTS,
+              particles->effect_x[e] - size / 2.0f,
+              particles->effect_y[e] - size / 2.0f, size, size,
+              (SDL_Color){red, green, blue, 255});
+  }
+
+  // All debris shares one colour, so it sorts into a single run
+  SDL_Color particle_color = {255, 255, 0, 255};
+  for (int i = 0; i < particles->count; i++) {
+    emit_quad(commands, RENDER_LAYER_EFFECTS,
+              particles->x[i] - PARTICLE_SIZE / 2.0f,
+              particles->y[i] - PARTICLE_SIZE / 2.0f, PARTICLE_SIZE,
+              PARTICLE_SIZE, particle_color);
+  }
+}
@@ -0,0 +1,42 @@
+#ifndef PARTICLES_H
+#define PARTICLES_H
+
+#include "arena.h"
+#include "renderCommands.h"
+#include <SDL2/SDL.h>
+
+// Pool sizes. Spawns past the limit are dropped.
+#define MAX_EFFECTS 256
+#define MAX_PARTICLES 4096
+
+// Seconds an explosion flash lasts
+#define EXPLOSION_TIME 0.3f
+
+// Explosion flashes and their debris, kept apart from the enemy store so a
+// dying enemy can leave it immediately. Both pools are structure-of-arrays
+// and packed: live entries are always 0..count-1.
+typedef struct {
+  // Explosion flashes (a square that grows and fades to yellow)
+  float *effect_x, *effect_y; // Centre
+  float *effect_size;         // Size at the start of the flash
+  float *effect_time;         // Seconds left
+  Uint8 *effect_kind;         // Enemy type that exploded (picks the colour)
+  int effect_count;
+
+  // Debris particles
+  float *x, *y;
+  float *vx, *vy;
+  float *life; // Seconds left
+  int count;
+} ParticleSystem;
+
+// Function declarations
+int initialize_particles(ParticleSystem *particles, Arena *arena);
+void reset_particles(ParticleSystem *particles);
+void spawn_explosion(ParticleSystem *particles, float center_x,
+                     float center_y, float size, int enemy_type,
+                     int particle_count);
+void update_particles(ParticleSystem *particles, float frame_time);
+void draw_particles(ParticleSystem *particles, RenderCommandBuffer *commands);
+
+#endif
@@ -1,6 +1,5 @@
 #include "projectile.h"
 #include "enemy.h"
-#include <SDL2/SDL_mixer.h>
 #include <math.h>
 #include <stdio.h>
 
@@ -11,7 +10,7 @@ void update_player_projectiles(Projectile *projectiles, int *count, int max,
                                int window_h, EnemyProjectile *enemy_projectiles,
                                int *enemy_proj_count, int enemy_max,
                                float frame_time, PlayerUpgrades *upgrades,
-                               Mix_Chunk *explode_sound) {
+                               VoiceManager *audio) {
   for (int i = 0; i < *count; i++) {
     if (projectiles[i].alive) {
       projectiles[i].x += projectiles[i].vx * frame_time;
@@ -19,17 +18,15 @@ void update_player_projectiles(Projectile *projectiles, int *count, int max,
 
       // Check collision with enemies
       for (int j = 0; j < enemies->current_enemy_count; j++) {
-        if (enemies->enemies_array[j].is_alive &&
-            !enemies->enemies_array[j].is_exploding) {
+        if (enemies->enemies_array[j].is_alive) {
           Enemy *e = &enemies->enemies_array[j];
           if (check_collision(projectiles[i].x, projectiles[i].y, 5, 5,
                               e->position_x, e->position_y, e->width,
                               e->height)) {
             e->health_points -= 10 + 5 * upgrades->damage_level;
              if (e->health_points <= 0) {
-               e->is_exploding = 1;
-               e->explosion_timer = 0.3f;
-               if (explode_sound) Mix_PlayChannel(-1, explode_sound, 0);
+               e->is_alive = 0;
+               audio_trigger(audio, SOUND_EXPLODE);
                *score += 5;
               if (e->enemy_type == 2 && !e->has_spawned_death_projectiles) {
                 spawn_purple_enemy_death_projectiles(
@@ -100,26 +97,24 @@ void update_enemy_projectiles(EnemyProjectile *projectiles, int *count, int max,
 
 // Draw all active player projectiles
 void draw_player_projectiles(Projectile *projectiles, int count,
-                             SDL_Renderer *renderer) {
-  SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255); // Yellow
+                             RenderCommandBuffer *commands) {
+  SDL_Color color = {255, 255, 0, 255}; // Yellow
   for (int i = 0; i < count; i++) {
     if (projectiles[i].alive) {
-      SDL_FRect proj_rect = {projectiles[i].x - 2.5f, projectiles[i].y - 2.5f,
-                             5, 5};
-      SDL_RenderFillRectF(renderer, &proj_rect);
+      emit_quad(commands, RENDER_LAYER_PROJECTILES, projectiles[i].x - 2.5f,
+                projectiles[i].y - 2.5f, 5, 5, color);
     }
   }
 }
 
 // Draw all active enemy projectiles
 void draw_enemy_projectiles(EnemyProjectile *projectiles, int count,
-                            SDL_Renderer *renderer) {
-  SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255); // Red
+                            RenderCommandBuffer *commands) {
+  SDL_Color color = {255, 0, 0, 255}; // Red
   for (int i = 0; i < count; i++) {
     if (projectiles[i].alive) {
-      SDL_FRect ep_rect = {projectiles[i].x - 2.5f, projectiles[i].y - 2.5f, 5,
-                           5};
-      SDL_RenderFillRectF(renderer, &ep_rect);
+      emit_quad(commands, RENDER_LAYER_PROJECTILES, projectiles[i].x - 2.5f,
+                projectiles[i].y - 2.5f, 5, 5, color);
     }
   }
 }
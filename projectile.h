@@ -2,9 +2,13 @@
 #define PROJECTILE_H
 
 #include "enemy.h"
+#include "renderCommands.h"
 #include "upgrades.h"
 #include <SDL2/SDL.h>
-#include <SDL2/SDL_mixer.h>
+
+// Store sizes for the projectile arrays
+#define MAX_PLAYER_PROJECTILES 30
+#define MAX_ENEMY_PROJECTILES 50
 
 // Player's projectile struct
 typedef struct {
@@ -27,7 +31,7 @@ void update_player_projectiles(Projectile *projectiles, int *count, int max,
                                int window_h, EnemyProjectile *enemy_projectiles,
                                int *enemy_proj_count, int enemy_max,
                                float frame_time, PlayerUpgrades *upgrades,
-                               Mix_Chunk *explode_sound);
+                               VoiceManager *audio);
 
 // Update enemy projectiles: move, check collisions with player, remove out of
 // bounds
@@ -38,11 +42,11 @@ void update_enemy_projectiles(EnemyProjectile *projectiles, int *count, int max,
 
 // Draw player projectiles as yellow squares
 void draw_player_projectiles(Projectile *projectiles, int count,
-                             SDL_Renderer *renderer);
+                             RenderCommandBuffer *commands);
 
 // Draw enemy projectiles as red squares
 void draw_enemy_projectiles(EnemyProjectile *projectiles, int count,
-                            SDL_Renderer *renderer);
+                            RenderCommandBuffer *commands);
 
 // Spawn 8 projectiles in a circle when a purple enemy dies
 void spawn_purple_enemy_death_projectiles(Enemy *e,
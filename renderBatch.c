@@ -0,0 +1,83 @@
+#include "renderBatch.h"
+#include <stdio.h>
+
+int render_batch_init(RenderBatch *batch, SDL_Renderer *renderer, Arena *arena,
+                      int max_quads) {
+  batch->renderer = renderer;
+  batch->texture = NULL;
+  batch->quad_count = 0;
+  batch->draw_calls = 0;
+  batch->vertices = arena_alloc(arena, sizeof(SDL_Vertex) * 4 * max_quads);
+  batch->indices = arena_alloc(arena, sizeof(int) * 6 * max_quads);
+  if (!batch->vertices || !batch->indices) {
+    batch->max_quads = 0;
+    return 0;
+  }
+  batch->max_quads = max_quads;
+
+  // The index pattern never changes, so build it once
+  for (int i = 0; i < max_quads; i++) {
+    int *quad = &batch->indices[i * 6];
+    int first = i * 4;
+    quad[0] = first;
+    quad[1] = first + 1;
+    quad[2] = first + 2;
+    quad[3] = first + 2;
+    quad[4] = first + 3;
+    quad[5] = first;
+  }
+  return 1;
+}
+
+void render_batch_flush(RenderBatch *batch) {
+  if (batch->quad_count == 0)
+    return;
+  if (SDL_RenderGeometry(batch->renderer, batch->texture, batch->vertices,
+                         batch->quad_count * 4, batch->indices,
+                         batch->quad_count * 6) < 0) {
+    printf("Warning: SDL_RenderGeometry failed: %s\n", SDL_GetError());
+  }
+  batch->quad_count = 0;
+  batch->draw_calls++;
+}
+
+void render_batch_reset_stats(RenderBatch *batch) { batch->draw_calls = 0; }
+
+// Make room for one quad drawn with the given texture
+static SDL_Vertex *reserve_quad(RenderBatch *batch, SDL_Texture *texture) {
+  if (texture != batch->texture) {
+    render_batch_flush(batch);
+    batch->texture = texture;
+  }
+  if (batch->quad_count >= batch->max_quads) {
+    render_batch_flush(batch);
+    if (batch->max_quads == 0)
+      return NULL;
+  }
+  return &batch->vertices[batch->quad_count++ * 4];
+}
+
+void render_batch_fill_rect(RenderBatch *batch, float x, float y, float w,
+                            float h, SDL_Color color) {
+  SDL_Vertex *v = reserve_quad(batch, NULL);
+  if (!v)
+    return;
+  v[0] = (SDL_Vertex){{x, y}, color, {0.0f, 0.0f}};
+  v[1] = (SDL_Vertex){{x + w, y}, color, {0.0f, 0.0f}};
+  v[2] = (SDL_Vertex){{x + w, y + h}, color, {0.0f, 0.0f}};
+  v[3] = (SDL_Vertex){{x, y + h}, color, {0.0f, 0.0f}};
+}
+
+void render_batch_textured_quad(RenderBatch *batch, SDL_Texture *texture,
+                                const SDL_FRect *dst, float u0, float v0,
+                                float u1, float v1, SDL_Color color) {
+  SDL_Vertex *v = reserve_quad(batch, texture);
+  if (!v)
+    return;
+  float x2 = dst->x + dst->w;
+  float y2 = dst->y + dst->h;
+  v[0] = (SDL_Vertex){{dst->x, dst->y}, color, {u0, v0}};
+  v[1] = (SDL_Vertex){{x2, dst->y}, color, {u1, v0}};
+  v[2] = (SDL_Vertex){{x2, y2}, color, {u1, v1}};
+  v[3] = (SDL_Vertex){{dst->x, y2}, color, {u0, v1}};
+}
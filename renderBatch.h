@@ -0,0 +1,31 @@
+#ifndef RENDERBATCH_H
+#define RENDERBATCH_H
+
+#include "arena.h"
+#include <SDL2/SDL.h>
+
+// Collects coloured (optionally textured) quads into one vertex array and
+// submits them with a single SDL_RenderGeometry call per flush. The batch
+// flushes itself when it fills up or when the texture changes.
+typedef struct {
+  SDL_Renderer *renderer;
+  SDL_Texture *texture; // Texture of the quads currently queued (or NULL)
+  SDL_Vertex *vertices;
+  int *indices; // Fixed 0-1-2 2-3-0 pattern for every quad slot
+  int quad_count;
+  int max_quads;
+  int draw_calls; // Submissions since the last render_batch_reset_stats
+} RenderBatch;
+
+// Function declarations
+int render_batch_init(RenderBatch *batch, SDL_Renderer *renderer, Arena *arena,
+                      int max_quads);
+void render_batch_fill_rect(RenderBatch *batch, float x, float y, float w,
+                            float h, SDL_Color color);
+void render_batch_textured_quad(RenderBatch *batch, SDL_Texture *texture,
+                                const SDL_FRect *dst, float u0, float v0,
+                                float u1, float v1, SDL_Color color);
+void render_batch_flush(RenderBatch *batch);
+void render_batch_reset_stats(RenderBatch *batch);
+
+#endif
@@ -0,0 +1,272 @@
+#include "renderCommands.h"
+#include <string.h>
+
+static SDL_Texture *render_textures[RENDER_TEXTURE_COUNT];
+
+// CPU copies of the textures, for the software rasterizer
+typedef struct {
+  const Uint32 *pixels; // ARGB8888
+  int width, height;
+} TexturePixels;
+static TexturePixels render_texture_pixels[RENDER_TEXTURE_COUNT];
+
+int render_commands_init(RenderCommandBuffer *buffer, Arena *arena,
+                         int capacity) {
+  buffer->commands = arena_alloc(arena, sizeof(RenderCommand) * capacity);
+  buffer->capacity = buffer->commands ? capacity : 0;
+  buffer->count = 0;
+  buffer->culled = 0;
+  buffer->dropped = 0;
+  buffer->state_changes = 0;
+  return buffer->commands != NULL;
+}
+
+void render_commands_clear(RenderCommandBuffer *buffer) {
+  buffer->count = 0;
+  buffer->culled = 0;
+  buffer->dropped = 0;
+  buffer->state_changes = 0;
+}
+
+// Copy another buffer's commands onto the end of this one, as far as they
+// fit. Commands the source itself dropped count as dropped here too.
+void render_commands_append(RenderCommandBuffer *buffer,
+                            const RenderCommandBuffer *source) {
+  int count = source->count;
+  buffer->dropped += source->dropped;
+  if (count > buffer->capacity - buffer->count) {
+    buffer->dropped += count - (buffer->capacity - buffer->count);
+    count = buffer->capacity - buffer->count;
+  }
+  memcpy(&buffer->commands[buffer->count], source->commands,
+         sizeof(RenderCommand) * count);
+  buffer->count += count;
+}
+
+void emit_quad(RenderCommandBuffer *buffer, RenderLayer layer, float x,
+               float y, float w, float h, SDL_Color color) {
+  if (buffer->count >= buffer->capacity) {
+    buffer->dropped++;
+    return;
+  }
+  RenderCommand *command = &buffer->commands[buffer->count++];
+  command->x = x;
+  command->y = y;
+  command->w = w;
+  command->h = h;
+  command->color = color;
+  command->layer = layer;
+  command->texture = RENDER_TEXTURE_NONE;
+  command->kind = RENDER_KIND_QUAD;
+}
+
+void emit_textured_quad(RenderCommandBuffer *buffer, RenderLayer layer,
+                        RenderTextureId texture, float x, float y, float w,
+                        float h, float u0, float v0, float u1, float v1,
+                        SDL_Color color) {
+  if (buffer->count >= buffer->capacity) {
+    buffer->dropped++;
+    return;
+  }
+  RenderCommand *command = &buffer->commands[buffer->count++];
+  command->x = x;
+  command->y = y;
+  command->w = w;
+  command->h = h;
+  command->u0 = u0;
+  command->v0 = v0;
+  command->u1 = u1;
+  command->v1 = v1;
+  command->color = color;
+  command->layer = layer;
+  command->texture = texture;
+  command->kind = RENDER_KIND_QUAD;
+}
+
+void emit_line(RenderCommandBuffer *buffer, RenderLayer layer, float x0,
+               float y0, float x1, float y1, SDL_Color color) {
+  if (buffer->count >= buffer->capacity) {
+    buffer->dropped++;
+    return;
+  }
+  RenderCommand *command = &buffer->commands[buffer->count++];
+  command->x = x0;
+  command->y = y0;
+  command->w = x1 - x0;
+  command->h = y1 - y0;
+  command->color = color;
+  command->layer = layer;
+  command->texture = RENDER_TEXTURE_NONE;
+  command->kind = RENDER_KIND_LINE;
+}
+
+void register_render_texture(RenderTextureId id, SDL_Texture *texture) {
+  render_textures[id] = texture;
+}
+
+void register_render_texture_pixels(RenderTextureId id, const Uint32 *pixels,
+                                    int width, int height) {
+  render_texture_pixels[id].pixels = pixels;
+  render_texture_pixels[id].width = width;
+  render_texture_pixels[id].height = height;
+}
+
+const Uint32 *get_render_texture_pixels(RenderTextureId id, int *width,
+                                        int *height) {
+  *width = render_texture_pixels[id].width;
+  *height = render_texture_pixels[id].height;
+  return render_texture_pixels[id].pixels;
+}
+
+// Sort key: layer first so draw order is kept, then texture so consecutive
+// commands share a texture. Nothing else goes in: the sort is stable, so
+// commands with the same layer and texture keep the order they were emitted
+// in and overlapping translucent ones blend the same way every frame.
+static Uint32 command_sort_key(const RenderCommand *command) {
+  return ((Uint32)command->layer << 8) | command->texture;
+}
+
+// Stable LSD radix sort of (key, index) pairs, 8 bits per pass. Passes where
+// every key has the same byte are skipped. Returns whichever index array ends
+// up holding the sorted order.
+static Uint32 *radix_sort(Uint32 *keys, Uint32 *indices, Uint32 *keys_tmp,
+                          Uint32 *indices_tmp, int count) {
+  for (int shift = 0; shift < 32; shift += 8) {
+    int histogram[256];
+    memset(histogram, 0, sizeof(histogram));
+    for (int i = 0; i < count; i++)
+      histogram[(keys[i] >> shift) & 0xFF]++;
+    if (histogram[(keys[0] >> shift) & 0xFF] == count)
+      continue;
+
+    int offset = 0;
+    for (int b = 0; b < 256; b++) {
+      int bucket = histogram[b];
+      histogram[b] = offset;
+      offset += bucket;
+    }
+    for (int i = 0; i < count; i++) {
+      int slot = histogram[(keys[i] >> shift) & 0xFF]++;
+      keys_tmp[slot] = keys[i];
+      indices_tmp[slot] = indices[i];
+    }
+
+    Uint32 *swap = keys;
+    keys = keys_tmp;
+    keys_tmp = swap;
+    swap = indices;
+    indices = indices_tmp;
+    indices_tmp = swap;
+  }
+  return indices;
+}
+
+// Lines can have a negative extent, quads can't
+static int is_offscreen(const RenderCommand *command, int viewport_w,
+                        int viewport_h) {
+  float min_x = command->w < 0 ? command->x + command->w : command->x;
+  float min_y = command->h < 0 ? command->y + command->h : command->y;
+  float max_x = command->w < 0 ? command->x : command->x + command->w;
+  float max_y = command->h < 0 ? command->y : command->y + command->h;
+  return max_x < 0 || max_y < 0 || min_x > viewport_w || min_y > viewport_h;
+}
+
+static void replay_command(const RenderCommand *command, RenderBatch *batch) {
+  if (command->kind == RENDER_KIND_LINE) {
+    // Rare; lines go straight to the renderer between batches
+    render_batch_flush(batch);
+    SDL_SetRenderDrawColor(batch->renderer, command->color.r,
+                           command->color.g, command->color.b,
+                           command->color.a);
+    SDL_RenderDrawLineF(batch->renderer, command->x, command->y,
+                        command->x + command->w, command->y + command->h);
+  } else if (command->texture == RENDER_TEXTURE_NONE) {
+    render_batch_fill_rect(batch, command->x, command->y, command->w,
+                           command->h, command->color);
+  } else {
+    SDL_FRect dst = {command->x, command->y, command->w, command->h};
+    render_batch_textured_quad(batch, render_textures[command->texture], &dst,
+                               command->u0, command->v0, command->u1,
+                               command->v1, command->color);
+  }
+}
+
+// Cull against the viewport, sort by layer and texture and replay the
+// survivors into the batch. Sort buffers come from the scratch arena.
+void render_commands_submit(RenderCommandBuffer *buffer, RenderBatch *batch,
+                            int viewport_w, int viewport_h, Arena *scratch) {
+  render_commands_submit_layers(buffer, batch, 0, RENDER_LAYER_COUNT - 1,
+                                viewport_w, viewport_h, scratch);
+}
+
+// Cull layers first..last against the viewport and sort the survivors by
+// layer and texture. Returns how many survived and points order at
+// their indices, drawing order first. Sort buffers come from the scratch
+// arena; if it is full the order is left NULL and -1 returned.
+int render_commands_sort(RenderCommandBuffer *buffer, RenderLayer first,
+                         RenderLayer last, int viewport_w, int viewport_h,
+                         Arena *scratch, const Uint32 **order) {
+  int count = buffer->count;
+  *order = NULL;
+  if (count == 0)
+    return 0;
+
+  Uint32 *keys = arena_alloc(scratch, sizeof(Uint32) * count);
+  Uint32 *indices = arena_alloc(scratch, sizeof(Uint32) * count);
+  Uint32 *keys_tmp = arena_alloc(scratch, sizeof(Uint32) * count);
+  Uint32 *indices_tmp = arena_alloc(scratch, sizeof(Uint32) * count);
+  if (!keys || !indices || !keys_tmp || !indices_tmp)
+    return -1;
+
+  int visible = 0;
+  for (int i = 0; i < count; i++) {
+    const RenderCommand *command = &buffer->commands[i];
+    if (command->layer < first || command->layer > last)
+      continue;
+    if (is_offscreen(command, viewport_w, viewport_h)) {
+      buffer->culled++;
+      continue;
+    }
+    keys[visible] = command_sort_key(command);
+    indices[visible] = i;
+    visible++;
+  }
+  if (visible == 0)
+    return 0;
+
+  *order = radix_sort(keys, indices, keys_tmp, indices_tmp, visible);
+  return visible;
+}
+
+// Same as render_commands_submit, restricted to layers first..last so a
+// frame can be drawn in passes (e.g. world into a render target, HUD on
+// top). Statistics accumulate until the buffer is cleared.
+void render_commands_submit_layers(RenderCommandBuffer *buffer,
+                                   RenderBatch *batch, RenderLayer first,
+                                   RenderLayer last, int viewport_w,
+                                   int viewport_h, Arena *scratch) {
+  const Uint32 *order;
+  int visible = render_commands_sort(buffer, first, last, viewport_w,
+                                     viewport_h, scratch, &order);
+  if (visible < 0) {
+    // Out of scratch space: draw unsorted rather than not at all
+    for (int i = 0; i < buffer->count; i++) {
+      const RenderCommand *command = &buffer->commands[i];
+      if (command->layer >= first && command->layer <= last)
+        replay_command(command, batch);
+    }
+    render_batch_flush(batch);
+    return;
+  }
+
+  int current_texture = -1;
+  for (int i = 0; i < visible; i++) {
+    const RenderCommand *command = &buffer->commands[order[i]];
+    if (command->texture != current_texture) {
+      current_texture = command->texture;
+      buffer->state_changes++;
+    }
+    replay_command(command, batch);
+  }
+  render_batch_flush(batch);
+}
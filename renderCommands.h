@@ -0,0 +1,82 @@
+#ifndef RENDERCOMMANDS_H
+#define RENDERCOMMANDS_H
+
+#include "arena.h"
+#include "renderBatch.h"
+#include <SDL2/SDL.h>
+
+// Draw order. Lower layers are drawn first.
+typedef enum {
+  RENDER_LAYER_BACKGROUND,
+  RENDER_LAYER_STARS,
+  RENDER_LAYER_ENEMIES,
+  RENDER_LAYER_EFFECTS,
+  RENDER_LAYER_HEALTH_BG,
+  RENDER_LAYER_HEALTH_FG,
+  RENDER_LAYER_PROJECTILES,
+  RENDER_LAYER_PLAYER,
+  RENDER_LAYER_HUD,
+  RENDER_LAYER_CURSOR,
+  RENDER_LAYER_COUNT
+} RenderLayer;
+
+// Textures a command can reference. Commands only carry the id, so they
+// can be generated without touching SDL. Textures can also register their
+// CPU pixels for the software rasterizer.
+typedef enum {
+  RENDER_TEXTURE_NONE,
+  RENDER_TEXTURE_GLYPHS,
+  RENDER_TEXTURE_CROSSHAIR,
+  RENDER_TEXTURE_COUNT
+} RenderTextureId;
+
+typedef enum { RENDER_KIND_QUAD, RENDER_KIND_LINE } RenderCommandKind;
+
+typedef struct {
+  float x, y, w, h;     // Lines run from (x, y) to (x + w, y + h)
+  float u0, v0, u1, v1; // Only used by textured commands
+  SDL_Color color;
+  Uint8 layer;
+  Uint8 texture;
+  Uint8 kind;
+} RenderCommand;
+
+typedef struct {
+  RenderCommand *commands;
+  int count;
+  int capacity;
+  int culled;        // Commands dropped since the last clear
+  int dropped;       // Commands that did not fit since the last clear
+  int state_changes; // Texture switches since the last clear
+} RenderCommandBuffer;
+
+// Function declarations
+int render_commands_init(RenderCommandBuffer *buffer, Arena *arena,
+                         int capacity);
+void render_commands_clear(RenderCommandBuffer *buffer);
+void render_commands_append(RenderCommandBuffer *buffer,
+                            const RenderCommandBuffer *source);
+void emit_quad(RenderCommandBuffer *buffer, RenderLayer layer, float x,
+               float y, float w, float h, SDL_Color color);
+void emit_textured_quad(RenderCommandBuffer *buffer, RenderLayer layer,
+                        RenderTextureId texture, float x, float y, float w,
+                        float h, float u0, float v0, float u1, float v1,
+                        SDL_Color color);
+void emit_line(RenderCommandBuffer *buffer, RenderLayer layer, float x0,
+               float y0, float x1, float y1, SDL_Color color);
+void register_render_texture(RenderTextureId id, SDL_Texture *texture);
+void register_render_texture_pixels(RenderTextureId id, const Uint32 *pixels,
+                                    int width, int height);
+const Uint32 *get_render_texture_pixels(RenderTextureId id, int *width,
+                                        int *height);
+int render_commands_sort(RenderCommandBuffer *buffer, RenderLayer first,
+                         RenderLayer last, int viewport_w, int viewport_h,
+                         Arena *scratch, const Uint32 **order);
+void render_commands_submit(RenderCommandBuffer *buffer, RenderBatch *batch,
+                            int viewport_w, int viewport_h, Arena *scratch);
+void render_commands_submit_layers(RenderCommandBuffer *buffer,
+                                   RenderBatch *batch, RenderLayer first,
+                                   RenderLayer last, int viewport_w,
+                                   int viewport_h, Arena *scratch);
+
+#endif
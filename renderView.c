@@ -0,0 +1,185 @@
+#include "renderView.h"
+#include "memtrack.h"
+#include <stdio.h>
+
+#define MIN_RENDER_SCALE 0.25f
+
+void render_view_init(RenderView *view, int logical_w, int logical_h,
+                      float render_scale, int linear) {
+  view->target = NULL;
+  view->fixed_w = logical_w;
+  view->fixed_h = logical_h;
+  view->logical_w = logical_w > 0 ? logical_w : 800;
+  view->logical_h = logical_h > 0 ? logical_h : 600;
+  view->render_scale = 1.0f;
+  view->target_w = 0;
+  view->target_h = 0;
+  view->linear = linear;
+  view->active = 0;
+  view->dest.x = 0;
+  view->dest.y = 0;
+  view->dest.w = view->logical_w;
+  view->dest.h = view->logical_h;
+  render_view_set_scale(view, render_scale);
+}
+
+void render_view_set_scale(RenderView *view, float render_scale) {
+  if (render_scale < MIN_RENDER_SCALE)
+    render_scale = MIN_RENDER_SCALE;
+  if (render_scale > 1.0f)
+    render_scale = 1.0f;
+  view->render_scale = render_scale;
+}
+
+// Work out the logical size and the letterboxed destination for this frame.
+// Call once per frame before events are mapped.
+void render_view_update(RenderView *view, int window_w, int window_h) {
+  if (view->fixed_w <= 0 || view->fixed_h <= 0) {
+    view->logical_w = window_w;
+    view->logical_h = window_h;
+    view->dest.x = 0;
+    view->dest.y = 0;
+    view->dest.w = window_w;
+    view->dest.h = window_h;
+    return;
+  }
+
+  // Largest rectangle with the logical aspect ratio that fits the window
+  view->logical_w = view->fixed_w;
+  view->logical_h = view->fixed_h;
+  int dest_w = window_w;
+  int dest_h = (int)((Sint64)window_w * view->fixed_h / view->fixed_w);
+  if (dest_h > window_h) {
+    dest_h = window_h;
+    dest_w = (int)((Sint64)window_h * view->fixed_w / view->fixed_h);
+  }
+  view->dest.x = (window_w - dest_w) / 2;
+  view->dest.y = (window_h - dest_h) / 2;
+  view->dest.w = dest_w;
+  view->dest.h = dest_h;
+}
+
+static void destroy_target(RenderView *view) {
+  if (view->target) {
+    SDL_DestroyTexture(view->target);
+    memtrack_forget_texture(view->target_w, view->target_h, 4);
+    view->target = NULL;
+  }
+}
+
+// Pixel size the world is rendered at this frame
+void render_view_target_size(const RenderView *view, int *width,
+                             int *height) {
+  *width = (int)(view->logical_w * view->render_scale + 0.5f);
+  *height = (int)(view->logical_h * view->render_scale + 0.5f);
+  if (*width < 1)
+    *width = 1;
+  if (*height < 1)
+    *height = 1;
+}
+
+// Bind the target for this frame's world drawing. Coordinates are target
+// pixels until render_view_use_logical. Does nothing (draws straight to the
+// window) when the world already matches the window 1:1.
+void render_view_begin(RenderView *view, SDL_Renderer *renderer) {
+  int target_w, target_h;
+  render_view_target_size(view, &target_w, &target_h);
+
+  view->active = 0;
+  if (target_w == view->dest.w && target_h == view->dest.h &&
+      view->dest.x == 0 && view->dest.y == 0) {
+    destroy_target(view);
+    view->target_w = target_w;
+    view->target_h = target_h;
+    return;
+  }
+  if (!SDL_RenderTargetSupported(renderer)) {
+    view->target_w = view->dest.w;
+    view->target_h = view->dest.h;
+    return;
+  }
+
+  if (!view->target || target_w != view->target_w ||
+      target_h != view->target_h) {
+    destroy_target(view);
+    view->target = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                                     SDL_TEXTUREACCESS_TARGET, target_w,
+                                     target_h);
+    if (!view->target) {
+      printf("Warning: Could not create world render target: %s\n",
+             SDL_GetError());
+      view->target_w = view->dest.w;
+      view->target_h = view->dest.h;
+      return;
+    }
+    SDL_SetTextureBlendMode(view->target, SDL_BLENDMODE_NONE);
+    SDL_SetTextureScaleMode(view->target, view->linear ? SDL_ScaleModeLinear
+                                                       : SDL_ScaleModeNearest);
+    memtrack_note_texture(target_w, target_h, 4);
+    view->target_w = target_w;
+    view->target_h = target_h;
+  }
+
+  view->active = 1;
+  SDL_SetRenderTarget(renderer, view->target);
+}
+
+// From here on the world is drawn in logical coordinates
+void render_view_use_logical(RenderView *view, SDL_Renderer *renderer) {
+  if (view->active) {
+    SDL_RenderSetScale(renderer, (float)view->target_w / view->logical_w,
+                       (float)view->target_h / view->logical_h);
+  } else if (view->dest.w != view->logical_w ||
+             view->dest.h != view->logical_h) {
+    // No target: draw straight into the letterbox
+    SDL_RenderSetViewport(renderer, &view->dest);
+    SDL_RenderSetScale(renderer, (float)view->dest.w / view->logical_w,
+                       (float)view->dest.h / view->logical_h);
+  }
+}
+
+// Stretch the finished world onto the window
+void render_view_end(RenderView *view, SDL_Renderer *renderer) {
+  if (!view->active) {
+    SDL_RenderSetScale(renderer, 1.0f, 1.0f);
+    SDL_RenderSetViewport(renderer, NULL);
+    return;
+  }
+  SDL_SetRenderTarget(renderer, NULL);
+  SDL_RenderSetScale(renderer, 1.0f, 1.0f);
+  if (view->dest.x != 0 || view->dest.y != 0) {
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderClear(renderer);
+  }
+  SDL_RenderCopy(renderer, view->target, NULL, &view->dest);
+}
+
+// Draw logical coordinates straight onto the window at native resolution,
+// on top of the scaled world (HUD, cursor)
+void render_view_begin_overlay(RenderView *view, SDL_Renderer *renderer) {
+  SDL_RenderSetViewport(renderer, &view->dest);
+  SDL_RenderSetScale(renderer, (float)view->dest.w / view->logical_w,
+                     (float)view->dest.h / view->logical_h);
+}
+
+void render_view_end_overlay(RenderView *view, SDL_Renderer *renderer) {
+  (void)view;
+  SDL_RenderSetScale(renderer, 1.0f, 1.0f);
+  SDL_RenderSetViewport(renderer, NULL);
+}
+
+void render_view_to_logical(const RenderView *view, float window_x,
+                            float window_y, float *logical_x,
+                            float *logical_y) {
+  *logical_x = (window_x - view->dest.x) * view->logical_w / view->dest.w;
+  *logical_y = (window_y - view->dest.y) * view->logical_h / view->dest.h;
+}
+
+// The device was lost along with the target; the next render_view_begin
+// creates it again (SDL_RENDER_DEVICE_RESET)
+void render_view_reset(RenderView *view) { destroy_target(view); }
+
+void render_view_destroy(RenderView *view) {
+  destroy_target(view);
+  view->active = 0;
+}
@@ -0,0 +1,39 @@
+#ifndef RENDERVIEW_H
+#define RENDERVIEW_H
+
+#include <SDL2/SDL.h>
+
+// Internal resolution the game world is drawn at. The world is rendered
+// into a target texture of logical size times render_scale and stretched
+// (letterboxed) onto the window, so fill cost no longer follows the window
+// size. Gameplay, mouse and HUD coordinates all live in logical space.
+typedef struct {
+  SDL_Texture *target;
+  int fixed_w, fixed_h;     // Requested logical size, 0 = follow the window
+  int logical_w, logical_h; // Current logical size
+  float render_scale;       // Target resolution relative to logical size
+  int target_w, target_h;   // Size of the target texture
+  int linear;               // Linear instead of nearest filtering
+  SDL_Rect dest;            // Where the world lands in the window
+  int active;               // Drawing through the target this frame
+} RenderView;
+
+// Function declarations
+void render_view_init(RenderView *view, int logical_w, int logical_h,
+                      float render_scale, int linear);
+void render_view_update(RenderView *view, int window_w, int window_h);
+void render_view_set_scale(RenderView *view, float render_scale);
+void render_view_target_size(const RenderView *view, int *width,
+                             int *height);
+void render_view_begin(RenderView *view, SDL_Renderer *renderer);
+void render_view_use_logical(RenderView *view, SDL_Renderer *renderer);
+void render_view_end(RenderView *view, SDL_Renderer *renderer);
+void render_view_begin_overlay(RenderView *view, SDL_Renderer *renderer);
+void render_view_end_overlay(RenderView *view, SDL_Renderer *renderer);
+void render_view_to_logical(const RenderView *view, float window_x,
+                            float window_y, float *logical_x,
+                            float *logical_y);
+void render_view_reset(RenderView *view);
+void render_view_destroy(RenderView *view);
+
+#endif
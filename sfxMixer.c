@@ -0,0 +1,148 @@
+#include "sfxMixer.h"
+#include "memtrack.h"
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define SFX_MIXER_SSE2
+#include <emmintrin.h>
+#endif
+
+int sfx_mixer_init(SfxMixer *mixer, int rate, int max_frames) {
+  memset(mixer, 0, sizeof(*mixer));
+  mixer->rate = rate;
+  mixer->max_frames = max_frames;
+  mixer->accumulator = mem_alloc(sizeof(float) * max_frames * 2, MEM_AUDIO);
+  SDL_AtomicSet(&mixer->stolen, 0);
+  SDL_AtomicSet(&mixer->mixed, 0);
+  if (!mixer->accumulator) {
+    printf("Warning: Could not set up the sound effect mixer\n");
+    sfx_mixer_shutdown(mixer);
+    return 0;
+  }
+  return 1;
+}
+
+// Start a voice at the sample matching start_time, stealing the one nearest
+// its end when all are busy. Audio thread only.
+void sfx_mixer_start(SfxMixer *mixer, const Mix_Chunk *chunk, float gain,
+                     Uint64 start_time) {
+  int slot = mixer->voice_count;
+  if (slot == SFX_MIXER_VOICES) {
+    slot = 0;
+    for (int i = 1; i < SFX_MIXER_VOICES; i++) {
+      if (mixer->voices[i].frames - mixer->voices[i].position <
+          mixer->voices[slot].frames - mixer->voices[slot].position)
+        slot = i;
+    }
+    SDL_AtomicAdd(&mixer->stolen, 1);
+  } else {
+    mixer->voice_count++;
+  }
+  SfxVoice *voice = &mixer->voices[slot];
+  voice->samples = (const Sint16 *)chunk->abuf;
+  voice->frames = chunk->alen / (2 * sizeof(Sint16));
+  voice->position = 0;
+  voice->gain = gain;
+  voice->start_time = start_time;
+}
+
+// Audio thread only
+void sfx_mixer_stop_all(SfxMixer *mixer) { mixer->voice_count = 0; }
+
+// accumulator[i] += samples[i] * gain
+static void accumulate(float *accumulator, const Sint16 *samples, int count,
+                       float gain) {
+  int i = 0;
+#ifdef SFX_MIXER_SSE2
+  __m128 factor = _mm_set1_ps(gain);
+  for (; i + 8 <= count; i += 8) {
+    __m128i packed = _mm_loadu_si128((const __m128i *)(samples + i));
+    // Sign-extend the 16-bit samples to 32 bits
+    __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(packed, packed), 16);
+    __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(packed, packed), 16);
+    __m128 sum_lo = _mm_loadu_ps(accumulator + i);
+    __m128 sum_hi = _mm_loadu_ps(accumulator + i + 4);
+    sum_lo = _mm_add_ps(sum_lo, _mm_mul_ps(_mm_cvtepi32_ps(lo), factor));
+    sum_hi = _mm_add_ps(sum_hi, _mm_mul_ps(_mm_cvtepi32_ps(hi), factor));
+    _mm_storeu_ps(accumulator + i, sum_lo);
+    _mm_storeu_ps(accumulator + i + 4, sum_hi);
+  }
+#endif
+  for (; i < count; i++)
+    accumulator[i] += samples[i] * gain;
+}
+
+// stream[i] = saturate(stream[i] + accumulator[i])
+static void resolve(Sint16 *stream, const float *accumulator, int count) {
+  int i = 0;
+#ifdef SFX_MIXER_SSE2
+  for (; i + 8 <= count; i += 8) {
+    __m128i packed = _mm_loadu_si128((const __m128i *)(stream + i));
+    __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(packed, packed), 16);
+    __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(packed, packed), 16);
+    lo = _mm_add_epi32(lo, _mm_cvtps_epi32(_mm_loadu_ps(accumulator + i)));
+    hi = _mm_add_epi32(hi,
+                       _mm_cvtps_epi32(_mm_loadu_ps(accumulator + i + 4)));
+    _mm_storeu_si128((__m128i *)(stream + i), _mm_packs_epi32(lo, hi));
+  }
+#endif
+  for (; i < count; i++) {
+    float value = stream[i] + accumulator[i];
+    if (value > 32767.0f)
+      value = 32767.0f;
+    if (value < -32768.0f)
+      value = -32768.0f;
+    stream[i] = (Sint16)(value < 0.0f ? value - 0.5f : value + 0.5f);
+  }
+}
+
+// Mix every active voice into one buffer of the stream. Audio thread only.
+void sfx_mixer_mix(SfxMixer *mixer, Sint16 *stream, int frames) {
+  Uint64 now = SDL_GetPerformanceCounter();
+  Uint64 frequency = SDL_GetPerformanceFrequency();
+  Uint64 previous = mixer->previous_callback ? mixer->previous_callback : now;
+  mixer->previous_callback = now;
+  if (frames > mixer->max_frames)
+    frames = mixer->max_frames;
+
+  SDL_AtomicSet(&mixer->mixed, mixer->voice_count);
+  if (mixer->voice_count == 0)
+    return;
+  memset(mixer->accumulator, 0, sizeof(float) * frames * 2);
+
+  for (int i = 0; i < mixer->voice_count;) {
+    SfxVoice *voice = &mixer->voices[i];
+    int offset = 0;
+    if (voice->position == 0) {
+      // The last buffer's worth of time maps onto this buffer
+      if (voice->start_time > previous) {
+        offset = (int)((voice->start_time - previous) * mixer->rate /
+                       frequency);
+      }
+      if (offset >= frames)
+        offset = frames - 1;
+    }
+    Uint32 count = voice->frames - voice->position;
+    if (count > (Uint32)(frames - offset))
+      count = frames - offset;
+    accumulate(mixer->accumulator + offset * 2,
+               voice->samples + voice->position * 2, (int)count * 2,
+               voice->gain);
+    voice->position += count;
+
+    if (voice->position >= voice->frames) {
+      *voice = mixer->voices[--mixer->voice_count];
+    } else {
+      i++;
+    }
+  }
+
+  resolve(stream, mixer->accumulator, frames * 2);
+}
+
+void sfx_mixer_shutdown(SfxMixer *mixer) {
+  mem_free(mixer->accumulator);
+  mixer->accumulator = NULL;
+  mixer->voice_count = 0;
+}
@@ -0,0 +1,45 @@
+#ifndef SFXMIXER_H
+#define SFXMIXER_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+
+// Voices the game mixer plays at once
+#define SFX_MIXER_VOICES 96
+
+typedef struct {
+  const Sint16 *samples; // Interleaved stereo in the device format
+  Uint32 frames;
+  Uint32 position;   // Frames already mixed
+  float gain;        // Linear, master volume included
+  Uint64 start_time; // Counter time the voice was started
+} SfxVoice;
+
+// Game-owned mixer for sound effects, run from SDL_mixer's post-mix hook on
+// the audio thread. Chunks are already converted to the device format at
+// load time (16-bit stereo), so a voice is just a gain-and-accumulate pass
+// into a float buffer, done with SSE2 eight samples at a time. Voices start
+// at the sample matching when they were triggered instead of at the start
+// of the next buffer. Everything but the counters belongs to the audio
+// thread; voices are started from the audio command queue.
+typedef struct {
+  SfxVoice voices[SFX_MIXER_VOICES];
+  int voice_count;
+
+  float *accumulator; // One float per sample of the largest buffer
+  int max_frames;
+  int rate;
+  Uint64 previous_callback;
+  SDL_atomic_t stolen; // Voices cut short because all were busy
+  SDL_atomic_t mixed;  // Voices mixed by the last callback
+} SfxMixer;
+
+// Function declarations
+int sfx_mixer_init(SfxMixer *mixer, int rate, int max_frames);
+void sfx_mixer_start(SfxMixer *mixer, const Mix_Chunk *chunk, float gain,
+                     Uint64 start_time);
+void sfx_mixer_stop_all(SfxMixer *mixer);
+void sfx_mixer_mix(SfxMixer *mixer, Sint16 *stream, int frames);
+void sfx_mixer_shutdown(SfxMixer *mixer);
+
+#endif
@@ -0,0 +1,134 @@
+#include "simPipeline.h"
+#include <stdio.h>
+
+#define SNAPSHOT_INDEX_MASK 0x3
+#define SNAPSHOT_FRESH 0x4
+
+// Hand the snapshot just written to the reader and take the waiting one as
+// the next write target. Never blocks either side.
+static void publish_snapshot(SimPipeline *sim) {
+  build_game_snapshot(sim->game, &sim->snapshots[sim->write_index]);
+  int previous = SDL_AtomicSet(&sim->shared, sim->write_index | SNAPSHOT_FRESH);
+  sim->write_index = previous & SNAPSHOT_INDEX_MASK;
+}
+
+static void run_step(SimPipeline *sim) {
+  update_game(sim->game, &sim->input);
+  publish_snapshot(sim);
+}
+
+static int sim_thread_main(void *data) {
+  SimPipeline *sim = data;
+  for (;;) {
+    SDL_SemWait(sim->step_ready);
+    if (SDL_AtomicGet(&sim->quit))
+      break;
+    run_step(sim);
+    SDL_SemPost(sim->step_done);
+  }
+  return 0;
+}
+
+int sim_pipeline_init(SimPipeline *sim, GameState *game, Arena *arena,
+                      int command_capacity, int threaded) {
+  sim->game = game;
+  for (int i = 0; i < SIM_SNAPSHOT_COUNT; i++) {
+    if (!render_commands_init(&sim->snapshots[i].commands, arena,
+                              command_capacity)) {
+      return 0;
+    }
+    sim->snapshots[i].score = 0;
+    sim->snapshots[i].player_is_alive = 1;
+    sim->snapshots[i].enemy_count = 0;
+    sim->snapshots[i].step = 0;
+    sim->snapshots[i].input_count = 0;
+  }
+  sim->write_index = 0;
+  sim->read_index = 1;
+  SDL_AtomicSet(&sim->shared, 2);
+  SDL_AtomicSet(&sim->quit, 0);
+  sim->step_in_flight = 0;
+  sim->threaded = 0;
+  sim->step_ready = NULL;
+  sim->step_done = NULL;
+  sim->thread = NULL;
+
+  if (threaded) {
+    sim->step_ready = SDL_CreateSemaphore(0);
+    sim->step_done = SDL_CreateSemaphore(0);
+    if (sim->step_ready && sim->step_done) {
+      sim->thread = SDL_CreateThread(sim_thread_main, "simulation", sim);
+    }
+    if (sim->thread) {
+      sim->threaded = 1;
+    } else {
+      printf("Warning: Could not start simulation thread, running it inline: "
+             "%s\n",
+             SDL_GetError());
+      if (sim->step_ready)
+        SDL_DestroySemaphore(sim->step_ready);
+      if (sim->step_done)
+        SDL_DestroySemaphore(sim->step_done);
+      sim->step_ready = NULL;
+      sim->step_done = NULL;
+    }
+  }
+
+  // Start with a snapshot of the initial state so there is always one to draw
+  sim_pipeline_publish(sim);
+  return 1;
+}
+
+// Start the next simulation step. Waits for the previous one first, so the
+// worker is at most one step ahead of the frame being drawn.
+void sim_pipeline_step(SimPipeline *sim, const GameInput *input) {
+  sim_pipeline_wait(sim);
+  sim->input = *input;
+  if (sim->threaded) {
+    sim->step_in_flight = 1;
+    SDL_SemPost(sim->step_ready);
+  } else {
+    run_step(sim);
+  }
+}
+
+// Block until no step is running. Required before the main thread touches
+// the game state (restarts, upgrades).
+void sim_pipeline_wait(SimPipeline *sim) {
+  if (sim->step_in_flight) {
+    SDL_SemWait(sim->step_done);
+    sim->step_in_flight = 0;
+  }
+}
+
+// Publish the current state without stepping, e.g. after a restart
+void sim_pipeline_publish(SimPipeline *sim) {
+  sim_pipeline_wait(sim);
+  publish_snapshot(sim);
+}
+
+// Newest finished snapshot. Stays valid and unchanged until the next call.
+const GameSnapshot *sim_pipeline_latest(SimPipeline *sim) {
+  if (SDL_AtomicGet(&sim->shared) & SNAPSHOT_FRESH) {
+    int previous = SDL_AtomicSet(&sim->shared, sim->read_index);
+    sim->read_index = previous & SNAPSHOT_INDEX_MASK;
+  }
+  return &sim->snapshots[sim->read_index];
+}
+
+void sim_pipeline_shutdown(SimPipeline *sim) {
+  sim_pipeline_wait(sim);
+  if (sim->thread) {
+    SDL_AtomicSet(&sim->quit, 1);
+    SDL_SemPost(sim->step_ready);
+    SDL_WaitThread(sim->thread, NULL);
+    sim->thread = NULL;
+  }
+  if (sim->step_ready)
+    SDL_DestroySemaphore(sim->step_ready);
+  if (sim->step_done)
+    SDL_DestroySemaphore(sim->step_done);
+  sim->step_ready = NULL;
+  sim->step_done = NULL;
+  sim->threaded = 0;
+}
@@ -0,0 +1,40 @@
+#ifndef SIMPIPELINE_H
+#define SIMPIPELINE_H
+
+#include "arena.h"
+#include "game.h"
+#include <SDL2/SDL.h>
+
+// Snapshots in flight: one being written by the simulation, one being drawn
+// by the main thread and one waiting to be picked up
+#define SIM_SNAPSHOT_COUNT 3
+
+// Runs the simulation on a worker thread, one step per rendered frame, so a
+// frame costs max(sim, render) instead of their sum. Finished steps are
+// published as snapshots through a lock-free triple buffer.
+typedef struct {
+  GameState *game;
+  GameSnapshot snapshots[SIM_SNAPSHOT_COUNT];
+  SDL_atomic_t shared; // Index of the waiting snapshot, plus a fresh bit
+  int write_index;     // Only touched by whoever runs the step
+  int read_index;      // Only touched by the main thread
+
+  GameInput input; // Input for the step in flight
+  int step_in_flight;
+  int threaded;
+  SDL_atomic_t quit;
+  SDL_sem *step_ready;
+  SDL_sem *step_done;
+  SDL_Thread *thread;
+} SimPipeline;
+
+// Function declarations
+int sim_pipeline_init(SimPipeline *sim, GameState *game, Arena *arena,
+                      int command_capacity, int threaded);
+void sim_pipeline_step(SimPipeline *sim, const GameInput *input);
+void sim_pipeline_wait(SimPipeline *sim);
+void sim_pipeline_publish(SimPipeline *sim);
+const GameSnapshot *sim_pipeline_latest(SimPipeline *sim);
+void sim_pipeline_shutdown(SimPipeline *sim);
+
+#endif
@@ -0,0 +1,102 @@
+#include "soundBank.h"
+#include "memtrack.h"
+#include <stdio.h>
+#include <string.h>
+
+void sound_bank_init(SoundBank *bank) { memset(bank, 0, sizeof(*bank)); }
+
+// Load a WAV from the asset pack and convert it to the device format. Must
+// be called after the device is open. Returns NULL (with a warning) when the
+// asset can't be used.
+Mix_Chunk *sound_bank_load(SoundBank *bank, SoundId id, AssetPack *assets,
+                           const char *name) {
+  int frequency, channels;
+  Uint16 format;
+  if (!Mix_QuerySpec(&frequency, &format, &channels)) {
+    printf("Warning: Could not load %s: audio device not open\n", name);
+    return NULL;
+  }
+
+  SDL_AudioSpec spec;
+  Uint8 *wav;
+  Uint32 wav_bytes;
+  if (!SDL_LoadWAV_RW(asset_pack_open_rw(assets, name), 1, &spec, &wav,
+                      &wav_bytes)) {
+    printf("Warning: Could not load %s: %s\n", name, SDL_GetError());
+    return NULL;
+  }
+
+  SDL_AudioCVT cvt;
+  if (SDL_BuildAudioCVT(&cvt, spec.format, spec.channels, spec.freq, format,
+                        (Uint8)channels, frequency) < 0) {
+    printf("Warning: Could not convert %s: %s\n", name, SDL_GetError());
+    SDL_FreeWAV(wav);
+    return NULL;
+  }
+
+  // Convert in a scratch buffer big enough for the intermediate steps, then
+  // keep only what the result needs
+  Uint8 *converted = wav;
+  Uint32 bytes = wav_bytes;
+  if (cvt.needed) {
+    cvt.len = (int)wav_bytes;
+    cvt.buf = SDL_malloc((size_t)wav_bytes * cvt.len_mult);
+    if (!cvt.buf) {
+      printf("Warning: Out of memory converting %s\n", name);
+      SDL_FreeWAV(wav);
+      return NULL;
+    }
+    memcpy(cvt.buf, wav, wav_bytes);
+    SDL_FreeWAV(wav);
+    wav = NULL;
+    if (SDL_ConvertAudio(&cvt) < 0) {
+      printf("Warning: Could not convert %s: %s\n", name, SDL_GetError());
+      SDL_free(cvt.buf);
+      return NULL;
+    }
+    converted = cvt.buf;
+    bytes = (Uint32)cvt.len_cvt;
+  }
+
+  // Whole sample frames only
+  int frame_bytes = (SDL_AUDIO_BITSIZE(format) / 8) * channels;
+  bytes -= bytes % frame_bytes;
+  Uint8 *samples = mem_alloc(bytes, MEM_AUDIO);
+  if (samples)
+    memcpy(samples, converted, bytes);
+  if (wav) {
+    SDL_FreeWAV(wav);
+  } else {
+    SDL_free(cvt.buf);
+  }
+  if (!samples) {
+    printf("Warning: Out of memory loading %s\n", name);
+    return NULL;
+  }
+
+  Mix_Chunk *chunk = Mix_QuickLoad_RAW(samples, bytes);
+  if (!chunk) {
+    printf("Warning: Could not load %s: %s\n", name, Mix_GetError());
+    mem_free(samples);
+    return NULL;
+  }
+  bank->chunks[id] = chunk;
+  bank->samples[id] = samples;
+  bank->bytes += bytes;
+  memtrack_note_audio(bytes);
+  return chunk;
+}
+
+// Call after the device has stopped playing the chunks
+void sound_bank_free(SoundBank *bank) {
+  for (int i = 0; i < SOUND_COUNT; i++) {
+    if (!bank->chunks[i])
+      continue;
+    memtrack_forget_audio(bank->chunks[i]->alen);
+    Mix_FreeChunk(bank->chunks[i]); // Leaves the samples alone
+    mem_free(bank->samples[i]);
+    bank->chunks[i] = NULL;
+    bank->samples[i] = NULL;
+  }
+  bank->bytes = 0;
+}
@@ -0,0 +1,25 @@
+#ifndef SOUNDBANK_H
+#define SOUNDBANK_H
+
+#include "assetPack.h"
+#include "audio.h"
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+
+// Every sound effect, converted once at load time to the exact format the
+// device was opened with. Samples live in one tightly sized buffer per sound
+// and the chunks only point at them, so nothing is resampled or converted
+// while playing and no conversion slack stays resident.
+typedef struct {
+  Mix_Chunk *chunks[SOUND_COUNT];
+  Uint8 *samples[SOUND_COUNT];
+  Uint32 bytes; // Resident sample bytes across the bank
+} SoundBank;
+
+// Function declarations
+void sound_bank_init(SoundBank *bank);
+Mix_Chunk *sound_bank_load(SoundBank *bank, SoundId id, AssetPack *assets,
+                           const char *name);
+void sound_bank_free(SoundBank *bank);
+
+#endif
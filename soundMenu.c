@@ -1,17 +1,12 @@
 #include "soundMenu.h"
-#include <SDL2/SDL_mixer.h>
+#include "text.h"
 #include <stdio.h>
 
-// Forward declaration
-extern void draw_text(SDL_Renderer *renderer, const char *text, float x, float y, SDL_Color color, float scale);
-
 void initialize_sound_menu(SoundMenu *menu) {
   menu->is_active = 0;
   menu->selected_option = SOUND_VOLUME_UP;
   menu->option_count = SOUND_OPTION_COUNT;
-  menu->master_volume = 128; // max
-  Mix_Volume(-1, menu->master_volume);
-  Mix_VolumeMusic(menu->master_volume);
+  menu->master_volume = 128; // max, applied by the voice manager
 }
 
 void update_sound_menu(SoundMenu *menu, SDL_Event *event, int *show_sound) {
@@ -29,15 +24,11 @@ void update_sound_menu(SoundMenu *menu, SDL_Event *event, int *show_sound) {
           case SOUND_VOLUME_UP:
             if (menu->master_volume < 128) {
               menu->master_volume += 8;
-              Mix_Volume(-1, menu->master_volume);
-              Mix_VolumeMusic(menu->master_volume);
             }
             break;
           case SOUND_VOLUME_DOWN:
             if (menu->master_volume > 0) {
               menu->master_volume -= 8;
-              Mix_Volume(-1, menu->master_volume);
-              Mix_VolumeMusic(menu->master_volume);
             }
             break;
           case SOUND_BACK:
@@ -50,7 +41,18 @@ void update_sound_menu(SoundMenu *menu, SDL_Event *event, int *show_sound) {
   }
 }
 
-void draw_sound_menu(SoundMenu *menu, SDL_Renderer *renderer, int window_w, int window_h) {
+void draw_sound_menu(SoundMenu *menu, SDL_Renderer *renderer, UiPanel *panel, int window_w, int window_h) {
+  // Only re-render when the selection, volume or window size changed
+  unsigned long key = ui_hash_int(UI_HASH_SEED, 2);
+  key = ui_hash_int(key, menu->selected_option);
+  key = ui_hash_int(key, menu->master_volume);
+  key = ui_hash_int(key, window_w);
+  key = ui_hash_int(key, window_h);
+  if (!ui_panel_begin(panel, renderer, window_w, window_h, key)) {
+    ui_panel_draw(panel, renderer);
+    return;
+  }
+
   // Clear screen
   SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
   SDL_RenderClear(renderer);
@@ -76,4 +78,7 @@ void draw_sound_menu(SoundMenu *menu, SDL_Renderer *renderer, int window_w, int
   SDL_Color instr_color = {200, 200, 200, 255};
   const char *instr = "USE UP/DOWN TO SELECT, ENTER TO CONFIRM";
   draw_text(renderer, instr, window_w / 2 - 200, window_h - 50, instr_color, 1.0f);
+
+  ui_panel_end(panel, renderer);
+  ui_panel_draw(panel, renderer);
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #ifndef SOUNDMENU_H
 #define SOUNDMENU_H
 
+#include "uiCache.h"
 #include <SDL2/SDL.h>
 
 typedef enum {
@@ -20,6 +21,6 @@ typedef struct {
 // Function declarations
 void initialize_sound_menu(SoundMenu *menu);
 void update_sound_menu(SoundMenu *menu, SDL_Event *event, int *show_sound);
-void draw_sound_menu(SoundMenu *menu, SDL_Renderer *renderer, int window_w, int window_h);
+void draw_sound_menu(SoundMenu *menu, SDL_Renderer *renderer, UiPanel *panel, int window_w, int window_h);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include "spriteCache.h"
+#include "memtrack.h"
+#include <math.h>
+#include <stdio.h>
+
+// Crosshair: white ring, radius 8 with a 1px thickening on each side
+#define CROSSHAIR_RADIUS 8.0f
+#define CROSSHAIR_HALF_THICKNESS 1.0f
+#define CROSSHAIR_SIZE 21
+
+static Sprite sprites[SPRITE_COUNT];
+
+// Render command texture id of each sprite
+static const RenderTextureId sprite_textures[SPRITE_COUNT] = {
+    RENDER_TEXTURE_CROSSHAIR};
+
+static void rasterize_crosshair(Sprite *sprite) {
+  float center = (CROSSHAIR_SIZE - 1) / 2.0f;
+  for (int y = 0; y < CROSSHAIR_SIZE; y++) {
+    for (int x = 0; x < CROSSHAIR_SIZE; x++) {
+      float dx = x - center;
+      float dy = y - center;
+      float distance = sqrtf(dx * dx + dy * dy);
+      int on_ring =
+          fabsf(distance - CROSSHAIR_RADIUS) <= CROSSHAIR_HALF_THICKNESS;
+      sprite->pixels[y * CROSSHAIR_SIZE + x] = on_ring ? 0xFFFFFFFF : 0;
+    }
+  }
+  sprite->origin_x = center;
+  sprite->origin_y = center;
+}
+
+// Copy the sprite's pixels into a new texture
+static int upload_sprite(Sprite *sprite, SDL_Renderer *renderer) {
+  sprite->texture =
+      SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                        SDL_TEXTUREACCESS_STATIC, sprite->width,
+                        sprite->height);
+  if (!sprite->texture) {
+    printf("Error: Could not create sprite texture: %s\n", SDL_GetError());
+    return 0;
+  }
+  SDL_UpdateTexture(sprite->texture, NULL, sprite->pixels,
+                    sprite->width * sizeof(Uint32));
+  SDL_SetTextureBlendMode(sprite->texture, SDL_BLENDMODE_BLEND);
+  SDL_SetTextureScaleMode(sprite->texture, SDL_ScaleModeNearest);
+  memtrack_note_texture(sprite->width, sprite->height, 4);
+  return 1;
+}
+
+static int create_sprite(Sprite *sprite, SDL_Renderer *renderer, Arena *arena,
+                         int width, int height,
+                         void (*rasterize)(Sprite *sprite)) {
+  sprite->width = width;
+  sprite->height = height;
+  sprite->pixels = arena_alloc_zeroed(arena, sizeof(Uint32) * width * height);
+  if (!sprite->pixels)
+    return 0;
+  rasterize(sprite);
+  return upload_sprite(sprite, renderer);
+}
+
+int sprite_cache_init(SDL_Renderer *renderer, Arena *arena) {
+  if (!create_sprite(&sprites[SPRITE_CROSSHAIR], renderer, arena,
+                     CROSSHAIR_SIZE, CROSSHAIR_SIZE, rasterize_crosshair))
+    return 0;
+  for (int i = 0; i < SPRITE_COUNT; i++) {
+    register_render_texture(sprite_textures[i], sprites[i].texture);
+    register_render_texture_pixels(sprite_textures[i], sprites[i].pixels,
+                                   sprites[i].width, sprites[i].height);
+  }
+  return 1;
+}
+
+void sprite_cache_shutdown(void) {
+  for (int i = 0; i < SPRITE_COUNT; i++) {
+    if (sprites[i].texture) {
+      SDL_DestroyTexture(sprites[i].texture);
+      memtrack_forget_texture(sprites[i].width, sprites[i].height, 4);
+      sprites[i].texture = NULL;
+    }
+  }
+}
+
+// The device was lost along with the sprite textures; upload them again from
+// their CPU copies (SDL_RENDER_DEVICE_RESET)
+int sprite_cache_reset(SDL_Renderer *renderer) {
+  sprite_cache_shutdown();
+  int ok = 1;
+  for (int i = 0; i < SPRITE_COUNT; i++) {
+    if (sprites[i].pixels && !upload_sprite(&sprites[i], renderer))
+      ok = 0;
+    register_render_texture(sprite_textures[i], sprites[i].texture);
+  }
+  return ok;
+}
+
+const Sprite *get_sprite(SpriteId id) { return &sprites[id]; }
+
+void draw_sprite(SDL_Renderer *renderer, SpriteId id, float x, float y) {
+  const Sprite *sprite = &sprites[id];
+  if (!sprite->texture)
+    return;
+  SDL_FRect dst = {x - sprite->origin_x, y - sprite->origin_y, sprite->width,
+                   sprite->height};
+  SDL_RenderCopyF(renderer, sprite->texture, NULL, &dst);
+}
+
+void emit_sprite(RenderCommandBuffer *buffer, RenderLayer layer, SpriteId id,
+                 float x, float y) {
+  const Sprite *sprite = &sprites[id];
+  emit_textured_quad(buffer, layer, sprite_textures[id], x - sprite->origin_x,
+                     y - sprite->origin_y, sprite->width, sprite->height, 0.0f,
+                     0.0f, 1.0f, 1.0f, (SDL_Color){255, 255, 255, 255});
+}
@@ -0,0 +1,28 @@
+#ifndef SPRITECACHE_H
+#define SPRITECACHE_H
+
+#include "arena.h"
+#include "renderCommands.h"
+#include <SDL2/SDL.h>
+
+// Procedural UI shapes rasterized once at startup into small textures, so
+// drawing one is a single copy.
+typedef enum { SPRITE_CROSSHAIR, SPRITE_COUNT } SpriteId;
+
+typedef struct {
+  SDL_Texture *texture;
+  Uint32 *pixels; // ARGB8888 copy of the texture contents
+  int width, height;
+  float origin_x, origin_y; // Point that lands on the draw position
+} Sprite;
+
+// Function declarations
+int sprite_cache_init(SDL_Renderer *renderer, Arena *arena);
+void sprite_cache_shutdown(void);
+int sprite_cache_reset(SDL_Renderer *renderer);
+const Sprite *get_sprite(SpriteId id);
+void draw_sprite(SDL_Renderer *renderer, SpriteId id, float x, float y);
+void emit_sprite(RenderCommandBuffer *buffer, RenderLayer layer, SpriteId id,
+                 float x, float y);
+
+#endif
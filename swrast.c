@@ -0,0 +1,435 @@
+#include "swrast.h"
+#include "memtrack.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define SWRAST_SSE2
+#include <emmintrin.h>
+#endif
+
+// x / 255 for x up to 255 * 255, the same rounding the SSE2 path uses
+static inline Uint32 div255(Uint32 x) {
+  x += 128;
+  return (x + (x >> 8)) >> 8;
+}
+
+static inline Uint32 blend_pixel(Uint32 dst, Uint32 r, Uint32 g, Uint32 b,
+                                 Uint32 a) {
+  Uint32 inv = 255 - a;
+  Uint32 out_r = div255(r * a + ((dst >> 16) & 0xFF) * inv);
+  Uint32 out_g = div255(g * a + ((dst >> 8) & 0xFF) * inv);
+  Uint32 out_b = div255(b * a + (dst & 0xFF) * inv);
+  return 0xFF000000 | (out_r << 16) | (out_g << 8) | out_b;
+}
+
+static void fill_span(Uint32 *row, int count, Uint32 color) {
+  int i = 0;
+#ifdef SWRAST_SSE2
+  __m128i value = _mm_set1_epi32((int)color);
+  for (; i + 8 <= count; i += 8) {
+    _mm_storeu_si128((__m128i *)(row + i), value);
+    _mm_storeu_si128((__m128i *)(row + i + 4), value);
+  }
+  for (; i + 4 <= count; i += 4)
+    _mm_storeu_si128((__m128i *)(row + i), value);
+#endif
+  for (; i < count; i++)
+    row[i] = color;
+}
+
+static void blend_span(Uint32 *row, int count, SDL_Color color) {
+  int i = 0;
+#ifdef SWRAST_SSE2
+  // Four pixels at a time in 16-bit lanes: dst * (255 - a) + src * a
+  Uint32 a = color.a;
+  __m128i zero = _mm_setzero_si128();
+  __m128i src = _mm_set_epi16(0, (short)(color.r * a), (short)(color.g * a),
+                              (short)(color.b * a), 0, (short)(color.r * a),
+                              (short)(color.g * a), (short)(color.b * a));
+  __m128i factor = _mm_set1_epi16((short)(255 - a));
+  __m128i bias = _mm_set1_epi16(128);
+  __m128i opaque = _mm_set1_epi32((int)0xFF000000);
+  for (; i + 4 <= count; i += 4) {
+    __m128i dst = _mm_loadu_si128((__m128i *)(row + i));
+    __m128i lo = _mm_unpacklo_epi8(dst, zero);
+    __m128i hi = _mm_unpackhi_epi8(dst, zero);
+    lo = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(lo, factor), src), bias);
+    hi = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(hi, factor), src), bias);
+    lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+    hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+    _mm_storeu_si128((__m128i *)(row + i),
+                     _mm_or_si128(_mm_packus_epi16(lo, hi), opaque));
+  }
+#endif
+  for (; i < count; i++)
+    row[i] = blend_pixel(row[i], color.r, color.g, color.b, color.a);
+}
+
+static int intersect(const SDL_Rect *a, const SDL_Rect *b, SDL_Rect *out) {
+  int x0 = a->x > b->x ? a->x : b->x;
+  int y0 = a->y > b->y ? a->y : b->y;
+  int x1 = (a->x + a->w < b->x + b->w) ? a->x + a->w : b->x + b->w;
+  int y1 = (a->y + a->h < b->y + b->h) ? a->y + a->h : b->y + b->h;
+  out->x = x0;
+  out->y = y0;
+  out->w = x1 - x0;
+  out->h = y1 - y0;
+  return out->w > 0 && out->h > 0;
+}
+
+static void fill_quad(SoftwareRenderer *swrast, const RenderCommand *command,
+                      const SDL_Rect *area) {
+  SDL_Color color = command->color;
+  Uint32 *row = swrast->pixels + area->y * swrast->width + area->x;
+  if (color.a == 255) {
+    Uint32 value = 0xFF000000 | ((Uint32)color.r << 16) |
+                   ((Uint32)color.g << 8) | color.b;
+    for (int y = 0; y < area->h; y++, row += swrast->width)
+      fill_span(row, area->w, value);
+  } else if (color.a > 0) {
+    for (int y = 0; y < area->h; y++, row += swrast->width)
+      blend_span(row, area->w, color);
+  }
+}
+
+// Nearest-sampled, colour-modulated, alpha-blended texture copy (glyphs,
+// sprites)
+static void blit_quad(SoftwareRenderer *swrast, const RenderCommand *command,
+                      const SDL_Rect *area) {
+  int tex_w, tex_h;
+  const Uint32 *texels =
+      get_render_texture_pixels(command->texture, &tex_w, &tex_h);
+  if (!texels || command->w <= 0.0f || command->h <= 0.0f)
+    return;
+
+  // Texel column for every pixel column in the area (at most one tile)
+  int columns[SWRAST_TILE_SIZE];
+  float du = (command->u1 - command->u0) / (command->w * swrast->scale_x);
+  float left = command->x * swrast->scale_x;
+  for (int x = 0; x < area->w; x++) {
+    float u = command->u0 + (area->x + x + 0.5f - left) * du;
+    int column = (int)(u * tex_w);
+    columns[x] = column < 0 ? 0 : column >= tex_w ? tex_w - 1 : column;
+  }
+
+  SDL_Color color = command->color;
+  float dv = (command->v1 - command->v0) / (command->h * swrast->scale_y);
+  float top = command->y * swrast->scale_y;
+  for (int y = 0; y < area->h; y++) {
+    float v = command->v0 + (area->y + y + 0.5f - top) * dv;
+    int texel_row = (int)(v * tex_h);
+    if (texel_row < 0)
+      texel_row = 0;
+    if (texel_row >= tex_h)
+      texel_row = tex_h - 1;
+    const Uint32 *source = texels + texel_row * tex_w;
+    Uint32 *row = swrast->pixels + (area->y + y) * swrast->width + area->x;
+    for (int x = 0; x < area->w; x++) {
+      Uint32 texel = source[columns[x]];
+      Uint32 a = div255((texel >> 24) * color.a);
+      if (a == 0)
+        continue;
+      row[x] = blend_pixel(row[x], div255(((texel >> 16) & 0xFF) * color.r),
+                           div255(((texel >> 8) & 0xFF) * color.g),
+                           div255((texel & 0xFF) * color.b), a);
+    }
+  }
+}
+
+// Bresenham, plotting only the pixels inside the tile
+static void draw_line(SoftwareRenderer *swrast, const RenderCommand *command,
+                      const SDL_Rect *clip) {
+  int x0 = (int)floorf(command->x * swrast->scale_x);
+  int y0 = (int)floorf(command->y * swrast->scale_y);
+  int x1 = (int)floorf((command->x + command->w) * swrast->scale_x);
+  int y1 = (int)floorf((command->y + command->h) * swrast->scale_y);
+  int dx = x1 > x0 ? x1 - x0 : x0 - x1;
+  int dy = y1 > y0 ? y0 - y1 : y1 - y0;
+  int step_x = x0 < x1 ? 1 : -1;
+  int step_y = y0 < y1 ? 1 : -1;
+  int error = dx + dy;
+  SDL_Color color = command->color;
+
+  for (;;) {
+    if (x0 >= clip->x && x0 < clip->x + clip->w && y0 >= clip->y &&
+        y0 < clip->y + clip->h) {
+      Uint32 *pixel = &swrast->pixels[y0 * swrast->width + x0];
+      *pixel = blend_pixel(*pixel, color.r, color.g, color.b, color.a);
+    }
+    if (x0 == x1 && y0 == y1)
+      break;
+    int twice = 2 * error;
+    if (twice >= dy) {
+      error += dy;
+      x0 += step_x;
+    }
+    if (twice <= dx) {
+      error += dx;
+      y0 += step_y;
+    }
+  }
+}
+
+static void rasterize_tile(SoftwareRenderer *swrast, int tile) {
+  int tile_x = (tile % swrast->tiles_x) * SWRAST_TILE_SIZE;
+  int tile_y = (tile / swrast->tiles_x) * SWRAST_TILE_SIZE;
+  SDL_Rect clip = {tile_x, tile_y, SWRAST_TILE_SIZE, SWRAST_TILE_SIZE};
+  if (clip.x + clip.w > swrast->width)
+    clip.w = swrast->width - clip.x;
+  if (clip.y + clip.h > swrast->height)
+    clip.h = swrast->height - clip.y;
+
+  for (int i = swrast->bin_start[tile]; i < swrast->bin_start[tile + 1]; i++) {
+    Uint32 visible = swrast->bin_items[i];
+    const RenderCommand *command = &swrast->commands[swrast->order[visible]];
+    SDL_Rect area;
+    if (command->kind == RENDER_KIND_LINE) {
+      draw_line(swrast, command, &clip);
+    } else if (intersect(&swrast->bounds[visible], &clip, &area)) {
+      if (command->texture == RENDER_TEXTURE_NONE)
+        fill_quad(swrast, command, &area);
+      else
+        blit_quad(swrast, command, &area);
+    }
+  }
+}
+
+// Pull tiles until there are none left; the workers and the calling thread
+// all run this
+static void rasterize_tiles(SoftwareRenderer *swrast) {
+  int tile_count = swrast->tiles_x * swrast->tiles_y;
+  for (;;) {
+    int tile = SDL_AtomicAdd(&swrast->next_tile, 1);
+    if (tile >= tile_count)
+      break;
+    rasterize_tile(swrast, tile);
+  }
+}
+
+static int swrast_worker(void *data) {
+  SoftwareRenderer *swrast = data;
+  for (;;) {
+    SDL_SemWait(swrast->work_ready);
+    if (SDL_AtomicGet(&swrast->quit))
+      break;
+    rasterize_tiles(swrast);
+    SDL_SemPost(swrast->work_done);
+  }
+  return 0;
+}
+
+// threads is the total including the caller; 0 picks one per CPU core
+int swrast_init(SoftwareRenderer *swrast, int threads) {
+  memset(swrast, 0, sizeof(*swrast));
+  if (threads <= 0)
+    threads = SDL_GetCPUCount();
+  int workers = threads - 1;
+  if (workers > SWRAST_MAX_THREADS)
+    workers = SWRAST_MAX_THREADS;
+
+  if (workers > 0) {
+    swrast->work_ready = SDL_CreateSemaphore(0);
+    swrast->work_done = SDL_CreateSemaphore(0);
+    if (!swrast->work_ready || !swrast->work_done) {
+      printf("Warning: Could not start rasterizer threads: %s\n",
+             SDL_GetError());
+      workers = 0;
+    }
+  }
+  for (int i = 0; i < workers; i++) {
+    swrast->threads[i] = SDL_CreateThread(swrast_worker, "rasterizer", swrast);
+    if (!swrast->threads[i]) {
+      printf("Warning: Could not start rasterizer thread: %s\n",
+             SDL_GetError());
+      break;
+    }
+    swrast->thread_count++;
+  }
+  printf("Software rasterizer: %d thread(s)\n", swrast->thread_count + 1);
+  return 1;
+}
+
+static int ensure_framebuffer(SoftwareRenderer *swrast, int width,
+                              int height) {
+  size_t needed = (size_t)width * height;
+  if (needed > swrast->capacity) {
+    mem_free(swrast->pixels);
+    swrast->pixels = mem_alloc(needed * sizeof(Uint32), MEM_RENDER);
+    if (!swrast->pixels) {
+      printf("Warning: Could not allocate %dx%d framebuffer\n", width,
+             height);
+      swrast->capacity = 0;
+      return 0;
+    }
+    memset(swrast->pixels, 0, needed * sizeof(Uint32));
+    swrast->capacity = needed;
+  }
+  swrast->width = width;
+  swrast->height = height;
+  return 1;
+}
+
+// Rasterize the whole command buffer (logical coordinates) into a
+// width x height framebuffer
+void swrast_render(SoftwareRenderer *swrast, RenderCommandBuffer *commands,
+                   int logical_w, int logical_h, int width, int height,
+                   Arena *scratch) {
+  if (!ensure_framebuffer(swrast, width, height))
+    return;
+  swrast->scale_x = (float)width / logical_w;
+  swrast->scale_y = (float)height / logical_h;
+  swrast->tiles_x = (width + SWRAST_TILE_SIZE - 1) / SWRAST_TILE_SIZE;
+  swrast->tiles_y = (height + SWRAST_TILE_SIZE - 1) / SWRAST_TILE_SIZE;
+  int tile_count = swrast->tiles_x * swrast->tiles_y;
+
+  const Uint32 *order;
+  int visible = render_commands_sort(commands, 0, RENDER_LAYER_COUNT - 1,
+                                     logical_w, logical_h, scratch, &order);
+  SDL_Rect *bounds = arena_alloc(scratch, sizeof(SDL_Rect) * (visible + 1));
+  int *bin_start = arena_alloc(scratch, sizeof(int) * (tile_count + 1));
+  int *bin_cursor = arena_alloc(scratch, sizeof(int) * tile_count);
+  if (visible < 0 || !bounds || !bin_start || !bin_cursor) {
+    printf("Warning: Out of scratch memory for the software rasterizer\n");
+    return;
+  }
+
+  // Pixel bounds of every command, and how many tiles each one touches
+  SDL_Rect screen = {0, 0, width, height};
+  memset(bin_start, 0, sizeof(int) * (tile_count + 1));
+  for (int v = 0; v < visible; v++) {
+    const RenderCommand *command = &commands->commands[order[v]];
+    float left = command->w < 0 ? command->x + command->w : command->x;
+    float top = command->h < 0 ? command->y + command->h : command->y;
+    float right = command->w < 0 ? command->x : command->x + command->w;
+    float bottom = command->h < 0 ? command->y : command->y + command->h;
+    SDL_Rect rect;
+    if (command->kind == RENDER_KIND_LINE) {
+      // Endpoints are inclusive
+      rect.x = (int)floorf(left * swrast->scale_x);
+      rect.y = (int)floorf(top * swrast->scale_y);
+      rect.w = (int)floorf(right * swrast->scale_x) + 1 - rect.x;
+      rect.h = (int)floorf(bottom * swrast->scale_y) + 1 - rect.y;
+    } else {
+      // Pixels whose centres are inside the quad
+      rect.x = (int)floorf(left * swrast->scale_x + 0.5f);
+      rect.y = (int)floorf(top * swrast->scale_y + 0.5f);
+      rect.w = (int)floorf(right * swrast->scale_x + 0.5f) - rect.x;
+      rect.h = (int)floorf(bottom * swrast->scale_y + 0.5f) - rect.y;
+    }
+    if (!intersect(&rect, &screen, &bounds[v])) {
+      bounds[v].w = 0;
+      continue;
+    }
+    int tx0 = bounds[v].x / SWRAST_TILE_SIZE;
+    int ty0 = bounds[v].y / SWRAST_TILE_SIZE;
+    int tx1 = (bounds[v].x + bounds[v].w - 1) / SWRAST_TILE_SIZE;
+    int ty1 = (bounds[v].y + bounds[v].h - 1) / SWRAST_TILE_SIZE;
+    for (int ty = ty0; ty <= ty1; ty++)
+      for (int tx = tx0; tx <= tx1; tx++)
+        bin_start[ty * swrast->tiles_x + tx + 1]++;
+  }
+
+  // Counts to offsets, then drop every command into its tiles in order
+  for (int t = 0; t < tile_count; t++) {
+    bin_start[t + 1] += bin_start[t];
+    bin_cursor[t] = bin_start[t];
+  }
+  Uint32 *bin_items =
+      arena_alloc(scratch, sizeof(Uint32) * (bin_start[tile_count] + 1));
+  if (!bin_items) {
+    printf("Warning: Out of scratch memory for the software rasterizer\n");
+    return;
+  }
+  for (int v = 0; v < visible; v++) {
+    if (bounds[v].w <= 0)
+      continue;
+    int tx0 = bounds[v].x / SWRAST_TILE_SIZE;
+    int ty0 = bounds[v].y / SWRAST_TILE_SIZE;
+    int tx1 = (bounds[v].x + bounds[v].w - 1) / SWRAST_TILE_SIZE;
+    int ty1 = (bounds[v].y + bounds[v].h - 1) / SWRAST_TILE_SIZE;
+    for (int ty = ty0; ty <= ty1; ty++)
+      for (int tx = tx0; tx <= tx1; tx++)
+        bin_items[bin_cursor[ty * swrast->tiles_x + tx]++] = v;
+  }
+
+  swrast->commands = commands->commands;
+  swrast->order = order;
+  swrast->bounds = bounds;
+  swrast->bin_start = bin_start;
+  swrast->bin_items = bin_items;
+  SDL_AtomicSet(&swrast->next_tile, 0);
+
+  // Fan out, help, and wait for the stragglers
+  for (int i = 0; i < swrast->thread_count; i++)
+    SDL_SemPost(swrast->work_ready);
+  rasterize_tiles(swrast);
+  for (int i = 0; i < swrast->thread_count; i++)
+    SDL_SemWait(swrast->work_done);
+}
+
+// Upload the framebuffer and stretch it over dest
+void swrast_present(SoftwareRenderer *swrast, SDL_Renderer *renderer,
+                    const SDL_Rect *dest, int linear) {
+  if (!swrast->pixels)
+    return;
+  if (!swrast->texture || swrast->texture_w != swrast->width ||
+      swrast->texture_h != swrast->height) {
+    if (swrast->texture) {
+      SDL_DestroyTexture(swrast->texture);
+      memtrack_forget_texture(swrast->texture_w, swrast->texture_h, 4);
+    }
+    swrast->texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                                        SDL_TEXTUREACCESS_STREAMING,
+                                        swrast->width, swrast->height);
+    if (!swrast->texture) {
+      printf("Warning: Could not create framebuffer texture: %s\n",
+             SDL_GetError());
+      return;
+    }
+    SDL_SetTextureBlendMode(swrast->texture, SDL_BLENDMODE_NONE);
+    SDL_SetTextureScaleMode(swrast->texture, linear ? SDL_ScaleModeLinear
+                                                    : SDL_ScaleModeNearest);
+    memtrack_note_texture(swrast->width, swrast->height, 4);
+    swrast->texture_w = swrast->width;
+    swrast->texture_h = swrast->height;
+  }
+
+  SDL_UpdateTexture(swrast->texture, NULL, swrast->pixels,
+                    swrast->width * sizeof(Uint32));
+  if (dest->x != 0 || dest->y != 0) {
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderClear(renderer);
+  }
+  SDL_RenderCopy(renderer, swrast->texture, NULL, dest);
+}
+
+// The device was lost along with the framebuffer texture; the next
+// swrast_present creates it again (SDL_RENDER_DEVICE_RESET)
+void swrast_reset(SoftwareRenderer *swrast) {
+  if (swrast->texture) {
+    SDL_DestroyTexture(swrast->texture);
+    memtrack_forget_texture(swrast->texture_w, swrast->texture_h, 4);
+    swrast->texture = NULL;
+  }
+}
+
+void swrast_shutdown(SoftwareRenderer *swrast) {
+  SDL_AtomicSet(&swrast->quit, 1);
+  for (int i = 0; i < swrast->thread_count; i++)
+    SDL_SemPost(swrast->work_ready);
+  for (int i = 0; i < swrast->thread_count; i++)
+    SDL_WaitThread(swrast->threads[i], NULL);
+  swrast->thread_count = 0;
+  if (swrast->work_ready)
+    SDL_DestroySemaphore(swrast->work_ready);
+  if (swrast->work_done)
+    SDL_DestroySemaphore(swrast->work_done);
+  swrast->work_ready = NULL;
+  swrast->work_done = NULL;
+  swrast_reset(swrast);
+  mem_free(swrast->pixels);
+  swrast->pixels = NULL;
+  swrast->capacity = 0;
+}
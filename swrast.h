@@ -0,0 +1,51 @@
+#ifndef SWRAST_H
+#define SWRAST_H
+
+#include "arena.h"
+#include "renderCommands.h"
+#include <SDL2/SDL.h>
+
+#define SWRAST_TILE_SIZE 64
+#define SWRAST_MAX_THREADS 8
+
+// Software rasterizer for the render command stream, for machines without a
+// GPU. Commands are culled and sorted as usual, binned into screen tiles and
+// the tiles are rasterized in parallel straight into an ARGB8888
+// framebuffer, which is uploaded once per frame through a streaming
+// texture. The frame is expected to cover the whole screen (the background
+// layer), so the framebuffer is never cleared.
+typedef struct {
+  Uint32 *pixels; // Framebuffer
+  int width, height;
+  size_t capacity; // Pixels allocated
+  SDL_Texture *texture;
+  int texture_w, texture_h;
+
+  // The frame being rasterized, shared with the workers
+  const RenderCommand *commands;
+  const Uint32 *order;    // Visible commands in drawing order
+  const SDL_Rect *bounds; // Framebuffer pixels covered, per visible command
+  float scale_x, scale_y; // Logical to framebuffer pixels
+  int tiles_x, tiles_y;
+  const int *bin_start;    // Per tile into bin_items, tile count + 1 entries
+  const Uint32 *bin_items; // Visible command numbers in drawing order
+  SDL_atomic_t next_tile;
+
+  int thread_count; // Workers besides the calling thread
+  SDL_Thread *threads[SWRAST_MAX_THREADS];
+  SDL_sem *work_ready;
+  SDL_sem *work_done;
+  SDL_atomic_t quit;
+} SoftwareRenderer;
+
+// Function declarations
+int swrast_init(SoftwareRenderer *swrast, int threads);
+void swrast_render(SoftwareRenderer *swrast, RenderCommandBuffer *commands,
+                   int logical_w, int logical_h, int width, int height,
+                   Arena *scratch);
+void swrast_present(SoftwareRenderer *swrast, SDL_Renderer *renderer,
+                    const SDL_Rect *dest, int linear);
+void swrast_reset(SoftwareRenderer *swrast);
+void swrast_shutdown(SoftwareRenderer *swrast);
+
+#endif
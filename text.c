@@ -0,0 +1,228 @@
+#include "text.h"
+#include "memtrack.h"
+#include <stdio.h>
+
+// Atlas layout: one cell per ASCII code, 16 cells per row. Glyphs occupy the
+// top-left GLYPH_CELL_W x GLYPH_CELL_H of a cell; the extra padding row keeps
+// nearest sampling from bleeding into the next row.
+#define GLYPH_CELL_W 12
+#define GLYPH_CELL_H 10
+#define ATLAS_CELL_STRIDE_Y 12
+#define ATLAS_COLUMNS 16
+#define ATLAS_ROWS 8
+#define ATLAS_WIDTH (ATLAS_COLUMNS * GLYPH_CELL_W)
+#define ATLAS_HEIGHT (ATLAS_ROWS * ATLAS_CELL_STRIDE_Y)
+
+typedef struct {
+  unsigned char x, y, w, h;
+} GlyphRect;
+
+typedef struct {
+  char character;
+  unsigned char rect_count;
+  GlyphRect rects[6];
+} GlyphShape;
+
+// Blocky glyph shapes in font units (one unit is one pixel at scale 1).
+// Only the characters the game actually prints have a shape; anything else
+// still advances the pen but draws nothing.
+static const GlyphShape glyph_shapes[] = {
+    {'S', 5,
+     {{0, 0, 8, 2}, {0, 4, 8, 2}, {0, 8, 8, 2}, {0, 0, 2, 6}, {6, 4, 2, 6}}},
+    {'C', 3, {{0, 0, 8, 2}, {0, 8, 8, 2}, {0, 0, 2, 10}}},
+    {'O', 4, {{0, 0, 8, 2}, {0, 8, 8, 2}, {0, 0, 2, 10}, {6, 0, 2, 10}}},
+    {'R', 6,
+     {{0, 0, 8, 2}, {0, 4, 6, 2}, {0, 0, 2, 10}, {6, 2, 2, 2}, {6, 6, 2, 4},
+      {4, 6, 2, 2}}},
+    {'E', 4, {{0, 0, 8, 2}, {0, 4, 6, 2}, {0, 8, 8, 2}, {0, 0, 2, 10}}},
+    {':', 2, {{2, 2, 2, 2}, {2, 6, 2, 2}}},
+    {'0', 4, {{0, 0, 6, 2}, {0, 8, 6, 2}, {0, 0, 2, 10}, {4, 0, 2, 10}}},
+    {'1', 2, {{2, 0, 2, 10}, {0, 2, 4, 2}}},
+    {'2', 5,
+     {{0, 0, 6, 2}, {0, 4, 6, 2}, {0, 8, 6, 2}, {4, 2, 2, 2}, {0, 6, 2, 2}}},
+    {'G', 5,
+     {{0, 0, 8, 2}, {0, 8, 8, 2}, {0, 4, 6, 2}, {0, 0, 2, 10}, {6, 6, 2, 4}}},
+    {'A', 4, {{2, 0, 6, 2}, {0, 2, 2, 8}, {8, 2, 2, 8}, {2, 4, 6, 2}}},
+    {'M', 5,
+     {{0, 0, 2, 10}, {8, 0, 2, 10}, {2, 0, 2, 4}, {6, 0, 2, 4}, {4, 2, 2, 2}}},
+    {'V', 4, {{0, 0, 2, 6}, {2, 6, 2, 4}, {6, 6, 2, 4}, {8, 0, 2, 6}}},
+    {'T', 2, {{0, 0, 10, 2}, {4, 0, 2, 10}}},
+    {'Q', 6,
+     {{0, 0, 10, 2}, {0, 8, 8, 2}, {0, 0, 2, 10}, {8, 0, 2, 8}, {6, 6, 2, 2},
+      {8, 8, 2, 2}}},
+    {'U', 3, {{0, 0, 2, 8}, {8, 0, 2, 8}, {0, 8, 10, 2}}},
+    {'I', 1, {{4, 0, 2, 10}}},
+    {'3', 5,
+     {{0, 0, 8, 2}, {0, 4, 6, 2}, {0, 8, 8, 2}, {6, 2, 2, 2}, {6, 6, 2, 2}}},
+    {'4', 3, {{4, 0, 2, 10}, {0, 6, 6, 2}, {2, 0, 2, 6}}},
+    {'5', 5,
+     {{0, 0, 8, 2}, {0, 4, 8, 2}, {0, 8, 8, 2}, {0, 0, 2, 6}, {6, 4, 2, 6}}},
+    {'6', 5,
+     {{0, 0, 8, 2}, {0, 4, 8, 2}, {0, 8, 8, 2}, {0, 0, 2, 6}, {6, 4, 2, 6}}},
+    {'7', 2, {{0, 0, 8, 2}, {6, 0, 2, 10}}},
+    {'8', 5,
+     {{0, 0, 8, 2}, {0, 4, 6, 2}, {0, 8, 8, 2}, {0, 0, 2, 10}, {6, 0, 2, 10}}},
+    {'9', 5,
+     {{0, 0, 8, 2}, {0, 4, 8, 2}, {0, 8, 8, 2}, {0, 0, 2, 6}, {6, 0, 2, 10}}},
+    {'N', 5,
+     {{0, 0, 2, 10}, {8, 0, 2, 10}, {2, 0, 2, 2}, {4, 2, 2, 2}, {6, 4, 2, 6}}},
+    {'Y', 3, {{0, 0, 2, 4}, {8, 0, 2, 4}, {4, 4, 2, 6}}},
+    {'H', 3, {{0, 0, 2, 10}, {8, 0, 2, 10}, {2, 4, 6, 2}}},
+    {'P', 4, {{0, 0, 8, 2}, {0, 4, 6, 2}, {0, 0, 2, 10}, {6, 2, 2, 2}}},
+    {'D', 4, {{0, 0, 6, 2}, {0, 8, 6, 2}, {0, 0, 2, 10}, {4, 2, 2, 6}}},
+    {'K', 4, {{0, 0, 2, 10}, {6, 0, 2, 4}, {4, 4, 2, 2}, {6, 6, 2, 4}}},
+    {'B', 6,
+     {{0, 0, 6, 2}, {0, 4, 6, 2}, {0, 8, 6, 2}, {0, 0, 2, 10}, {6, 2, 2, 2},
+      {6, 6, 2, 2}}},
+    {'F', 3, {{0, 0, 8, 2}, {0, 4, 6, 2}, {0, 0, 2, 10}}},
+    {'L', 2, {{0, 0, 2, 10}, {0, 8, 8, 2}}},
+    {'W', 5,
+     {{0, 0, 2, 10}, {8, 0, 2, 10}, {2, 6, 2, 4}, {6, 6, 2, 4}, {4, 8, 2, 2}}},
+    {'.', 1, {{3, 8, 2, 2}}},
+    {'/', 3, {{6, 0, 2, 4}, {3, 3, 2, 4}, {0, 6, 2, 4}}},
+};
+
+// Horizontal advance per ASCII code in font units
+static const unsigned char glyph_advance[128] = {
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    6, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+};
+
+static SDL_Texture *atlas_texture = NULL;
+static Uint32 *atlas_pixels = NULL;
+static unsigned char glyph_present[128];
+static RenderBatch text_batch;
+
+// Upload the rasterized atlas into a new texture
+static int create_atlas_texture(SDL_Renderer *renderer) {
+  atlas_texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                                    SDL_TEXTUREACCESS_STATIC, ATLAS_WIDTH,
+                                    ATLAS_HEIGHT);
+  if (!atlas_texture) {
+    printf("Error: Could not create text atlas: %s\n", SDL_GetError());
+    return 0;
+  }
+  SDL_UpdateTexture(atlas_texture, NULL, atlas_pixels,
+                    ATLAS_WIDTH * sizeof(Uint32));
+  SDL_SetTextureBlendMode(atlas_texture, SDL_BLENDMODE_BLEND);
+  SDL_SetTextureScaleMode(atlas_texture, SDL_ScaleModeNearest);
+  memtrack_note_texture(ATLAS_WIDTH, ATLAS_HEIGHT, 4);
+  register_render_texture(RENDER_TEXTURE_GLYPHS, atlas_texture);
+  return 1;
+}
+
+int text_init(SDL_Renderer *renderer, Arena *arena) {
+  atlas_pixels = arena_alloc_zeroed(arena, sizeof(Uint32) * ATLAS_WIDTH *
+                                               ATLAS_HEIGHT);
+  if (!atlas_pixels ||
+      !render_batch_init(&text_batch, renderer, arena, 256)) {
+    printf("Error: Could not allocate text atlas\n");
+    return 0;
+  }
+
+  // Rasterize every glyph shape into its atlas cell once
+  int shape_count = sizeof(glyph_shapes) / sizeof(glyph_shapes[0]);
+  for (int i = 0; i < shape_count; i++) {
+    const GlyphShape *shape = &glyph_shapes[i];
+    int code = (unsigned char)shape->character;
+    int cell_x = (code % ATLAS_COLUMNS) * GLYPH_CELL_W;
+    int cell_y = (code / ATLAS_COLUMNS) * ATLAS_CELL_STRIDE_Y;
+    for (int r = 0; r < shape->rect_count; r++) {
+      const GlyphRect *rect = &shape->rects[r];
+      for (int py = rect->y; py < rect->y + rect->h; py++) {
+        for (int px = rect->x; px < rect->x + rect->w; px++) {
+          atlas_pixels[(cell_y + py) * ATLAS_WIDTH + cell_x + px] = 0xFFFFFFFF;
+        }
+      }
+    }
+    glyph_present[code] = 1;
+  }
+
+  if (!create_atlas_texture(renderer))
+    return 0;
+  register_render_texture_pixels(RENDER_TEXTURE_GLYPHS, atlas_pixels,
+                                 ATLAS_WIDTH, ATLAS_HEIGHT);
+  return 1;
+}
+
+void text_shutdown(void) {
+  if (atlas_texture) {
+    SDL_DestroyTexture(atlas_texture);
+    memtrack_forget_texture(ATLAS_WIDTH, ATLAS_HEIGHT, 4);
+    atlas_texture = NULL;
+  }
+}
+
+// The device was lost along with the atlas texture; upload it again from the
+// CPU copy (SDL_RENDER_DEVICE_RESET)
+int text_reset(SDL_Renderer *renderer) {
+  text_shutdown();
+  register_render_texture(RENDER_TEXTURE_GLYPHS, NULL);
+  return create_atlas_texture(renderer);
+}
+
+// Get text width
+float get_text_width(const char *text, float scale) {
+  int units = 0;
+  for (size_t i = 0; text[i] != '\0'; i++) {
+    unsigned char c = (unsigned char)text[i];
+    units += (c < 128) ? glyph_advance[c] : GLYPH_CELL_W;
+  }
+  return units * scale;
+}
+
+// Atlas texture coordinates of a glyph cell
+static void glyph_coords(unsigned char c, float *u0, float *v0, float *u1,
+                         float *v1) {
+  *u0 = (float)((c % ATLAS_COLUMNS) * GLYPH_CELL_W) / ATLAS_WIDTH;
+  *v0 = (float)((c / ATLAS_COLUMNS) * ATLAS_CELL_STRIDE_Y) / ATLAS_HEIGHT;
+  *u1 = *u0 + (float)GLYPH_CELL_W / ATLAS_WIDTH;
+  *v1 = *v0 + (float)GLYPH_CELL_H / ATLAS_HEIGHT;
+}
+
+// Draw text as one batch of textured quads from the glyph atlas
+void draw_text(SDL_Renderer *renderer, const char *text, float x, float y,
+               SDL_Color color, float scale) {
+  if (!atlas_texture)
+    return;
+  text_batch.renderer = renderer;
+
+  float current_x = x;
+  for (size_t i = 0; text[i] != '\0'; i++) {
+    unsigned char c = (unsigned char)text[i];
+    if (c < 128 && glyph_present[c]) {
+      SDL_FRect dst = {current_x, y, GLYPH_CELL_W * scale,
+                       GLYPH_CELL_H * scale};
+      float u0, v0, u1, v1;
+      glyph_coords(c, &u0, &v0, &u1, &v1);
+      render_batch_textured_quad(&text_batch, atlas_texture, &dst, u0, v0, u1,
+                                 v1, color);
+    }
+    current_x += ((c < 128) ? glyph_advance[c] : GLYPH_CELL_W) * scale;
+  }
+  render_batch_flush(&text_batch);
+}
+
+// Same as draw_text, but as render commands
+void emit_text(RenderCommandBuffer *buffer, RenderLayer layer,
+               const char *text, float x, float y, SDL_Color color,
+               float scale) {
+  float current_x = x;
+  for (size_t i = 0; text[i] != '\0'; i++) {
+    unsigned char c = (unsigned char)text[i];
+    if (c < 128 && glyph_present[c]) {
+      float u0, v0, u1, v1;
+      glyph_coords(c, &u0, &v0, &u1, &v1);
+      emit_textured_quad(buffer, layer, RENDER_TEXTURE_GLYPHS, current_x, y,
+                         GLYPH_CELL_W * scale, GLYPH_CELL_H * scale, u0, v0,
+                         u1, v1, color);
+    }
+    current_x += ((c < 128) ? glyph_advance[c] : GLYPH_CELL_W) * scale;
+  }
+}
@@ -0,0 +1,20 @@
+#ifndef TEXT_H
+#define TEXT_H
+
+#include "arena.h"
+#include "renderBatch.h"
+#include "renderCommands.h"
+#include <SDL2/SDL.h>
+
+// Function declarations
+int text_init(SDL_Renderer *renderer, Arena *arena);
+void text_shutdown(void);
+int text_reset(SDL_Renderer *renderer);
+void draw_text(SDL_Renderer *renderer, const char *text, float x, float y,
+               SDL_Color color, float scale);
+float get_text_width(const char *text, float scale);
+void emit_text(RenderCommandBuffer *buffer, RenderLayer layer,
+               const char *text, float x, float y, SDL_Color color,
+               float scale);
+
+#endif
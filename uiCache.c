@@ -0,0 +1,81 @@
+#include "uiCache.h"
+#include "memtrack.h"
+#include <stdio.h>
+#include <string.h>
+
+static void destroy_texture(SDL_Texture **texture, int width, int height) {
+  if (*texture) {
+    SDL_DestroyTexture(*texture);
+    memtrack_forget_texture(width, height, 4);
+    *texture = NULL;
+  }
+}
+
+void ui_panel_init(UiPanel *panel) { memset(panel, 0, sizeof(*panel)); }
+
+// Returns 1 when the caller has to redraw the panel contents. In that case
+// drawing goes to the panel's target until ui_panel_end.
+int ui_panel_begin(UiPanel *panel, SDL_Renderer *renderer, int width,
+                   int height, unsigned long key) {
+  if (!SDL_RenderTargetSupported(renderer))
+    return 1;
+
+  if (!panel->target || width != panel->width || height != panel->height) {
+    destroy_texture(&panel->target, panel->width, panel->height);
+    panel->target = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                                      SDL_TEXTUREACCESS_TARGET, width, height);
+    if (!panel->target) {
+      printf("Warning: Could not create menu texture: %s\n", SDL_GetError());
+      return 1;
+    }
+    SDL_SetTextureBlendMode(panel->target, SDL_BLENDMODE_NONE);
+    memtrack_note_texture(width, height, 4);
+    panel->width = width;
+    panel->height = height;
+    panel->valid = 0;
+  }
+
+  if (panel->valid && panel->key == key)
+    return 0;
+
+  panel->key = key;
+  panel->valid = 1;
+  panel->previous_target = SDL_GetRenderTarget(renderer);
+  SDL_SetRenderTarget(renderer, panel->target);
+  return 1;
+}
+
+void ui_panel_end(UiPanel *panel, SDL_Renderer *renderer) {
+  if (panel->target)
+    SDL_SetRenderTarget(renderer, panel->previous_target);
+}
+
+void ui_panel_draw(UiPanel *panel, SDL_Renderer *renderer) {
+  if (panel->target)
+    SDL_RenderCopy(renderer, panel->target, NULL, NULL);
+}
+
+// The renderer lost the target's contents (SDL_RENDER_TARGETS_RESET), or the
+// texture itself with the device (SDL_RENDER_DEVICE_RESET); either way the
+// next ui_panel_begin has the menu draw again
+void ui_panel_reset(UiPanel *panel, int device_lost) {
+  if (device_lost)
+    destroy_texture(&panel->target, panel->width, panel->height);
+  panel->valid = 0;
+}
+
+void ui_panel_destroy(UiPanel *panel) {
+  destroy_texture(&panel->target, panel->width, panel->height);
+  panel->valid = 0;
+}
+
+// FNV-1a style mixing of one int into a state key
+unsigned long ui_hash_int(unsigned long hash, int value) {
+  unsigned int bits = (unsigned int)value;
+  for (int i = 0; i < 4; i++) {
+    hash ^= (bits >> (i * 8)) & 0xFF;
+    hash *= 16777619UL;
+    hash &= 0xFFFFFFFFUL;
+  }
+  return hash;
+}
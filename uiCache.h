@@ -0,0 +1,31 @@
+#ifndef UICACHE_H
+#define UICACHE_H
+
+#include <SDL2/SDL.h>
+
+// Retained UI helper. A UiPanel is a window-sized render target that a menu
+// draws into only when its state key changes; every other frame it is a
+// single copy. Without render target support the menu draws immediately.
+
+#define UI_HASH_SEED 2166136261UL
+
+typedef struct {
+  SDL_Texture *target;
+  SDL_Texture *previous_target; // Restored by ui_panel_end
+  int width, height;
+  unsigned long key; // State key of what is currently in the target
+  int valid;
+} UiPanel;
+
+// Function declarations
+void ui_panel_init(UiPanel *panel);
+int ui_panel_begin(UiPanel *panel, SDL_Renderer *renderer, int width,
+                   int height, unsigned long key);
+void ui_panel_end(UiPanel *panel, SDL_Renderer *renderer);
+void ui_panel_draw(UiPanel *panel, SDL_Renderer *renderer);
+void ui_panel_reset(UiPanel *panel, int device_lost);
+void ui_panel_destroy(UiPanel *panel);
+
+unsigned long ui_hash_int(unsigned long hash, int value);
+
+#endif
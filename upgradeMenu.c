@@ -1,13 +1,11 @@
 #include "upgradeMenu.h"
 #include "mainMenu.h"
+#include "text.h"
 #include <SDL2/SDL.h>
 #include <stdio.h>
 #include <string.h>
 
 // Forward declarations
-void draw_text(SDL_Renderer *renderer, const char *text, float x, float y,
-               SDL_Color color, float scale);
-float get_text_width(const char *text, float scale);
 void save_coins(int coins);
 
 // Get damage upgrade cost based on current level
@@ -110,8 +108,23 @@ void update_upgrade_menu(UpgradeMenu *menu, SDL_Event *event,
   }
 }
 
-void draw_upgrade_menu(UpgradeMenu *menu, SDL_Renderer *renderer, int window_w,
-                        int window_h, int coins, PlayerUpgrades *upgrades) {
+void draw_upgrade_menu(UpgradeMenu *menu, SDL_Renderer *renderer,
+                       UiPanel *panel, int window_w, int window_h, int coins,
+                       PlayerUpgrades *upgrades) {
+   // Only re-render when the selection, coins, upgrades or window size changed
+   unsigned long key = ui_hash_int(UI_HASH_SEED, 3);
+   key = ui_hash_int(key, menu->selected_option);
+   key = ui_hash_int(key, coins);
+   key = ui_hash_int(key, upgrades->damage_level);
+   key = ui_hash_int(key, upgrades->double_shots);
+   key = ui_hash_int(key, upgrades->triple_shots);
+   key = ui_hash_int(key, window_w);
+   key = ui_hash_int(key, window_h);
+   if (!ui_panel_begin(panel, renderer, window_w, window_h, key)) {
+     ui_panel_draw(panel, renderer);
+     return;
+   }
+
    // Clear screen
    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
    SDL_RenderClear(renderer);
@@ -172,4 +185,7 @@ void draw_upgrade_menu(UpgradeMenu *menu, SDL_Renderer *renderer, int window_w,
     const char *instr = "USE UP/DOWN TO SELECT, ENTER TO BUY/BACK";
     float instr_width = get_text_width(instr, 1.0f);
     draw_text(renderer, instr, window_w / 2 - instr_width / 2, window_h - 50, instr_color, 1.0f);
+
+    ui_panel_end(panel, renderer);
+    ui_panel_draw(panel, renderer);
 }
@@ -2,6 +2,7 @@
 #define UPGRADEMENU_H
 
 #include "mainMenu.h"
+#include "uiCache.h"
 #include "upgrades.h"
 #include <SDL2/SDL.h>
 
@@ -22,7 +23,7 @@ typedef struct {
 // Function declarations
 void initialize_upgrade_menu(UpgradeMenu *menu);
 void update_upgrade_menu(UpgradeMenu *menu, SDL_Event *event, int *show_upgrades, int *coins, PlayerUpgrades *upgrades, MainMenu *main_menu);
-void draw_upgrade_menu(UpgradeMenu *menu, SDL_Renderer *renderer, int window_w, int window_h, int coins, PlayerUpgrades *upgrades);
+void draw_upgrade_menu(UpgradeMenu *menu, SDL_Renderer *renderer, UiPanel *panel, int window_w, int window_h, int coins, PlayerUpgrades *upgrades);
 void load_upgrades(PlayerUpgrades *upgrades);
 
 #endif
\ No newline at end of file